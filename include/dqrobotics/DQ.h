@@ -49,7 +49,14 @@ private:
 
     //Attributes
 public:
-    VectorXd q;
+    /**
+     * The eight coefficients of the dual quaternion, stored inline in a fixed-size (aligned) vector
+     * so that constructing, copying, and returning a DQ never touches the heap. Code that reads
+     * dq.q as an Eigen vector keeps working, and dq.q converts implicitly to a VectorXd if needed.
+     */
+    Matrix<double,8,1> q;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
     //Static Methods
 public:
@@ -64,7 +71,7 @@ public:
     //Methods
 public:
 
-    DQ(const VectorXd& v);
+    DQ(const Ref<const VectorXd>& v);
 
     DQ(const double& q0=0.0, const double& q1=0.0, const double& q2=0.0, const double& q3=0.0, const double& q4=0.0, const double& q5=0.0, const double& q6=0.0, const double& q7=0.0);
 
@@ -97,7 +104,14 @@ public:
 
     DQ pow(const double a) const;
 
+    DQ log_unchecked() const;
+
+    DQ exp_unchecked() const;
+
+    DQ pow_unchecked(const double a) const;
+
     DQ tplus() const;
+    DQ tplus_unchecked() const;
     inline DQ T() const{return tplus();}
 
     DQ pinv() const;
@@ -126,10 +140,6 @@ public:
 
     //Operator (-) Overload
     DQ operator-();
-    //Operator (==) Overload
-    bool operator==(const DQ& dq2) const;
-    //Operator (!=) Overload
-    bool operator!=(const DQ& dq2) const;
 
     //Conversion of DQ to other types
     explicit operator double() const;
@@ -171,6 +181,7 @@ DQ operator*(const DQ& dq, const double& scalar);
 DQ operator*(const double& scalar, const DQ& dq);
 
 //Operator (==) Overload
+bool operator==(const DQ& dq1, const DQ& dq2);
 bool operator==(const DQ& dq, const int& scalar);
 bool operator==(const int& scalar, const DQ& dq);
 bool operator==(const DQ& dq, const float &scalar);
@@ -179,6 +190,7 @@ bool operator==(const DQ& dq, const double& scalar);
 bool operator==(const double& scalar, const DQ& dq);
 
 //Operator (!=) Overload
+bool operator!=(const DQ& dq1, const DQ& dq2);
 bool operator!=(const DQ& dq, const int& scalar);
 bool operator!=(const int& scalar, const DQ& dq);
 bool operator!=(const DQ& dq, const float &scalar);
@@ -229,8 +241,15 @@ DQ exp(const DQ& dq);
 
 DQ pow(const DQ& dq, const double& a);
 
+DQ log_unchecked(const DQ& dq);
+
+DQ exp_unchecked(const DQ& dq);
+
+DQ pow_unchecked(const DQ& dq, const double& a);
+
 DQ tplus(const DQ& dq);
 inline DQ T(const DQ& dq){return tplus(dq);}
+DQ tplus_unchecked(const DQ& dq);
 
 DQ pinv(const DQ& dq);
 
@@ -244,6 +263,13 @@ Matrix<double,8,8> hamiplus8(const DQ& dq);
 
 Matrix<double,8,8> haminus8(const DQ& dq);
 
+//Structured products, the same as hamiplus8(dq)*matrix and haminus8(dq)*matrix for 8xn matrices
+MatrixXd hamiplus8_product(const DQ& dq, const Ref<const MatrixXd>& matrix);
+void     hamiplus8_product(const DQ& dq, const Ref<const MatrixXd>& matrix, Ref<MatrixXd> result);
+
+MatrixXd haminus8_product(const DQ& dq, const Ref<const MatrixXd>& matrix);
+void     haminus8_product(const DQ& dq, const Ref<const MatrixXd>& matrix, Ref<MatrixXd> result);
+
 Matrix<double,8,8> generalized_jacobian(const DQ& dq);
 
 Vector4d vec4(const DQ& dq);
@@ -258,8 +284,12 @@ DQ sharp(const DQ& dq);
 
 DQ cross(const DQ& dq1, const DQ& dq2);
 
+DQ cross_unchecked(const DQ& dq1, const DQ& dq2);
+
 DQ dot(const DQ& dq1, const DQ& dq2);
 
+DQ dot_unchecked(const DQ& dq1, const DQ& dq2);
+
 DQ Ad(const DQ& dq1, const DQ& dq2);
 
 DQ Adsharp(const DQ& dq1, const DQ& dq2);
@@ -0,0 +1,266 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_DQ_EXPRESSION_H
+#define DQ_ROBOTICS_DQ_EXPRESSION_H
+
+#include<dqrobotics/DQ.h>
+#include<dqrobotics/utils/DQ_CoefficientKernels.h>
+#include<dqrobotics/utils/DQ_Instrumentation.h>
+#include<cmath>
+
+/**
+ * Opt-in lazy evaluation of chained DQ arithmetic.
+ *
+ * Every DQ operator returns a DQ and runs the DQ_threshold cleanup on it, so conj(x2)*x1*x3 builds and cleans two
+ * intermediate DQs. Wrapping any operand with lazy() turns the whole chain into an expression that is only evaluated
+ * when it is converted to a DQ, with the products, sums, differences, negations, scalings, and conjugates computed on
+ * plain coefficients and the threshold applied once to the result:
+ *
+ *     DQ x = lazy(reference_frame)*raw_fkm(q)*effector;
+ *     DQ w = 0.5*lazy(r)*axis*conj(lazy(r));
+ *     J.col(j) = eval(s_j*lazy(z) + z*(conj(lazy(s_j)) + s)*x).q;
+ *
+ * Code that does not call lazy() is unaffected. The result may differ from the eager chain by about DQ_threshold in
+ * each coefficient, since the intermediate values are not thresholded.
+ *
+ * As with Eigen, expressions refer to their DQ operands, so they must be evaluated before the end of the full
+ * expression that creates them; do not store them with auto.
+ */
+namespace DQ_robotics
+{
+
+template<class Derived>
+class DQ_Expression
+{
+public:
+    const Derived& derived() const
+    {
+        return static_cast<const Derived&>(*this);
+    }
+
+    /**
+    * Evaluates the expression and thresholds the result once.
+    */
+    DQ eval() const
+    {
+        DQ result;
+        double* r = result.q.data();
+        derived().coefficients(r);
+        for(int n = 0; n < 8; n++)
+        {
+            if(std::fabs(r[n]) < DQ_threshold)
+                r[n] = 0;
+        }
+        return result;
+    }
+
+    operator DQ() const
+    {
+        return eval();
+    }
+};
+
+template<class Derived>
+DQ eval(const DQ_Expression<Derived>& expression)
+{
+    return expression.eval();
+}
+
+/**
+* A DQ operand, referred to and not copied.
+*/
+class DQ_ExpressionLeaf: public DQ_Expression<DQ_ExpressionLeaf>
+{
+private:
+    const DQ& dq_;
+public:
+    explicit DQ_ExpressionLeaf(const DQ& dq): dq_(dq) {}
+
+    void coefficients(double* r) const
+    {
+        const double* a = dq_.q.data();
+        for(int n = 0; n < 8; n++)
+            r[n] = a[n];
+    }
+};
+
+inline DQ_ExpressionLeaf lazy(const DQ& dq)
+{
+    return DQ_ExpressionLeaf(dq);
+}
+
+template<class L, class R>
+class DQ_ExpressionProduct: public DQ_Expression<DQ_ExpressionProduct<L,R>>
+{
+private:
+    const L left_;
+    const R right_;
+public:
+    DQ_ExpressionProduct(const L& left, const R& right): left_(left), right_(right) {}
+
+    void coefficients(double* r) const
+    {
+        DQROBOTICS_COUNT_DQ_PRODUCT();
+        double a[8];
+        double b[8];
+        left_.coefficients(a);
+        right_.coefficients(b);
+        dq_kernels::product(a, b, r);
+    }
+};
+
+/**
+* left + sign*right, with sign either 1 or -1.
+*/
+template<class L, class R, int sign>
+class DQ_ExpressionSum: public DQ_Expression<DQ_ExpressionSum<L,R,sign>>
+{
+private:
+    const L left_;
+    const R right_;
+public:
+    DQ_ExpressionSum(const L& left, const R& right): left_(left), right_(right) {}
+
+    void coefficients(double* r) const
+    {
+        double b[8];
+        left_.coefficients(r);
+        right_.coefficients(b);
+        for(int n = 0; n < 8; n++)
+            r[n] += sign*b[n];
+    }
+};
+
+template<class E>
+class DQ_ExpressionScaled: public DQ_Expression<DQ_ExpressionScaled<E>>
+{
+private:
+    const E expression_;
+    const double scalar_;
+public:
+    DQ_ExpressionScaled(const E& expression, const double& scalar): expression_(expression), scalar_(scalar) {}
+
+    void coefficients(double* r) const
+    {
+        expression_.coefficients(r);
+        for(int n = 0; n < 8; n++)
+            r[n] *= scalar_;
+    }
+};
+
+template<class E>
+class DQ_ExpressionConj: public DQ_Expression<DQ_ExpressionConj<E>>
+{
+private:
+    const E expression_;
+public:
+    explicit DQ_ExpressionConj(const E& expression): expression_(expression) {}
+
+    void coefficients(double* r) const
+    {
+        expression_.coefficients(r);
+        r[1] = -r[1]; r[2] = -r[2]; r[3] = -r[3];
+        r[5] = -r[5]; r[6] = -r[6]; r[7] = -r[7];
+    }
+};
+
+/*************************************************************************
+ *************************** EXPRESSION OPERATORS ***********************
+ ************************************************************************/
+
+//Operator (*) Overload
+template<class L, class R>
+DQ_ExpressionProduct<L,R> operator*(const DQ_Expression<L>& left, const DQ_Expression<R>& right)
+{
+    return DQ_ExpressionProduct<L,R>(left.derived(), right.derived());
+}
+template<class L>
+DQ_ExpressionProduct<L,DQ_ExpressionLeaf> operator*(const DQ_Expression<L>& left, const DQ& right)
+{
+    return DQ_ExpressionProduct<L,DQ_ExpressionLeaf>(left.derived(), DQ_ExpressionLeaf(right));
+}
+template<class R>
+DQ_ExpressionProduct<DQ_ExpressionLeaf,R> operator*(const DQ& left, const DQ_Expression<R>& right)
+{
+    return DQ_ExpressionProduct<DQ_ExpressionLeaf,R>(DQ_ExpressionLeaf(left), right.derived());
+}
+template<class E>
+DQ_ExpressionScaled<E> operator*(const DQ_Expression<E>& expression, const double& scalar)
+{
+    return DQ_ExpressionScaled<E>(expression.derived(), scalar);
+}
+template<class E>
+DQ_ExpressionScaled<E> operator*(const double& scalar, const DQ_Expression<E>& expression)
+{
+    return DQ_ExpressionScaled<E>(expression.derived(), scalar);
+}
+
+//Operator (+) Overload
+template<class L, class R>
+DQ_ExpressionSum<L,R,1> operator+(const DQ_Expression<L>& left, const DQ_Expression<R>& right)
+{
+    return DQ_ExpressionSum<L,R,1>(left.derived(), right.derived());
+}
+template<class L>
+DQ_ExpressionSum<L,DQ_ExpressionLeaf,1> operator+(const DQ_Expression<L>& left, const DQ& right)
+{
+    return DQ_ExpressionSum<L,DQ_ExpressionLeaf,1>(left.derived(), DQ_ExpressionLeaf(right));
+}
+template<class R>
+DQ_ExpressionSum<DQ_ExpressionLeaf,R,1> operator+(const DQ& left, const DQ_Expression<R>& right)
+{
+    return DQ_ExpressionSum<DQ_ExpressionLeaf,R,1>(DQ_ExpressionLeaf(left), right.derived());
+}
+
+//Operator (-) Overload
+template<class L, class R>
+DQ_ExpressionSum<L,R,-1> operator-(const DQ_Expression<L>& left, const DQ_Expression<R>& right)
+{
+    return DQ_ExpressionSum<L,R,-1>(left.derived(), right.derived());
+}
+template<class L>
+DQ_ExpressionSum<L,DQ_ExpressionLeaf,-1> operator-(const DQ_Expression<L>& left, const DQ& right)
+{
+    return DQ_ExpressionSum<L,DQ_ExpressionLeaf,-1>(left.derived(), DQ_ExpressionLeaf(right));
+}
+template<class R>
+DQ_ExpressionSum<DQ_ExpressionLeaf,R,-1> operator-(const DQ& left, const DQ_Expression<R>& right)
+{
+    return DQ_ExpressionSum<DQ_ExpressionLeaf,R,-1>(DQ_ExpressionLeaf(left), right.derived());
+}
+template<class E>
+DQ_ExpressionScaled<E> operator-(const DQ_Expression<E>& expression)
+{
+    return DQ_ExpressionScaled<E>(expression.derived(), -1.0);
+}
+
+//Conjugate
+template<class E>
+DQ_ExpressionConj<E> conj(const DQ_Expression<E>& expression)
+{
+    return DQ_ExpressionConj<E>(expression.derived());
+}
+
+}//Namespace DQRobotics
+
+#endif // DQ_ROBOTICS_DQ_EXPRESSION_H
@@ -0,0 +1,508 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_GENERICDQ_H
+#define DQ_ROBOTICS_GENERICDQ_H
+
+#include<dqrobotics/DQ.h>
+#include<dqrobotics/utils/DQ_CoefficientKernels.h>
+
+#include<cmath>
+
+namespace DQ_robotics
+{
+
+/**
+ * The values below which the coefficients of a GenericDQ<Scalar> are rounded to zero after an operation, the
+ * counterpart of DQ_threshold for each scalar type. Scalars without a specialization, e.g. automatic differentiation
+ * types, are never rounded, so their results are exactly those of the arithmetic.
+ */
+template<typename Scalar>
+struct DQ_ScalarTraits
+{
+    static Scalar threshold() { return Scalar(0); }
+    static void apply_threshold(Scalar&) {}
+};
+
+template<typename Scalar>
+struct DQ_FloatingPointScalarTraits
+{
+    static void apply_threshold(Scalar& x)
+    {
+        if(std::fabs(x) < DQ_ScalarTraits<Scalar>::threshold())
+            x = Scalar(0);
+    }
+};
+
+template<> struct DQ_ScalarTraits<float>: DQ_FloatingPointScalarTraits<float>
+{
+    static float threshold() { return 1e-6f; }
+};
+
+template<> struct DQ_ScalarTraits<double>: DQ_FloatingPointScalarTraits<double>
+{
+    static double threshold() { return DQ_threshold; }
+};
+
+template<> struct DQ_ScalarTraits<long double>: DQ_FloatingPointScalarTraits<long double>
+{
+    static long double threshold() { return 1e-15L; }
+};
+
+/**
+ * A dual quaternion whose coefficients are of type @p Scalar.
+ *
+ * DQ is the double-precision type used throughout the library. GenericDQ has the same algebra for other scalars:
+ * float, to trade precision for throughput, long double, or user-defined types with the usual arithmetic and math
+ * functions, e.g. automatic differentiation types. Math functions are called unqualified, so those of a user-defined
+ * type are found by argument-dependent lookup.
+ *
+ * The members are explicitly instantiated for float and double in the library. Other scalars are instantiated from
+ * this header.
+ *
+ * log(), exp(), and pow() do not validate their argument, like DQ::log_unchecked() and its siblings.
+ *
+ * Example:
+ *     GenericDQ<float> x(DQ(1) + 0.5*E_*i_);
+ *     GenericDQ<float> y = x*conj(x);
+ *     DQ z = y.to_dq();
+ */
+template<typename Scalar>
+class GenericDQ
+{
+public:
+    typedef Scalar scalar_type;
+    typedef Matrix<Scalar,8,1> Vector8;
+    typedef Matrix<Scalar,4,1> Vector4;
+
+    Vector8 q;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    GenericDQ(const Scalar& q0 = Scalar(0), const Scalar& q1 = Scalar(0), const Scalar& q2 = Scalar(0), const Scalar& q3 = Scalar(0),
+              const Scalar& q4 = Scalar(0), const Scalar& q5 = Scalar(0), const Scalar& q6 = Scalar(0), const Scalar& q7 = Scalar(0));
+    explicit GenericDQ(const Vector8& v);
+    explicit GenericDQ(const DQ& dq);
+
+    template<typename OtherScalar> GenericDQ<OtherScalar> cast() const;
+    DQ to_dq() const;
+
+    GenericDQ P() const;
+    GenericDQ D() const;
+    GenericDQ Re() const;
+    GenericDQ Im() const;
+    GenericDQ conj() const;
+    GenericDQ norm() const;
+    GenericDQ inv() const;
+    GenericDQ translation() const;
+    GenericDQ rotation() const;
+    GenericDQ log() const;
+    GenericDQ exp() const;
+    GenericDQ pow(const Scalar& a) const;
+    GenericDQ normalize() const;
+
+    Vector4 vec4() const;
+    Vector8 vec8() const;
+    Matrix<Scalar,8,8> hamiplus8() const;
+    Matrix<Scalar,8,8> haminus8() const;
+
+    void apply_threshold();
+};
+
+/* **********************************************************************
+ *  CONSTRUCTORS AND CONVERSIONS
+ * *********************************************************************/
+
+template<typename Scalar>
+GenericDQ<Scalar>::GenericDQ(const Scalar& q0, const Scalar& q1, const Scalar& q2, const Scalar& q3,
+                             const Scalar& q4, const Scalar& q5, const Scalar& q6, const Scalar& q7)
+{
+    q << q0, q1, q2, q3, q4, q5, q6, q7;
+    apply_threshold();
+}
+
+template<typename Scalar>
+GenericDQ<Scalar>::GenericDQ(const Vector8& v):
+    q(v)
+{
+}
+
+/**
+ * @brief GenericDQ converts each coefficient of @p dq to Scalar.
+ */
+template<typename Scalar>
+GenericDQ<Scalar>::GenericDQ(const DQ& dq)
+{
+    for(int n = 0; n < 8; n++)
+        q(n) = Scalar(dq.q(n));
+}
+
+/**
+ * @brief cast the same dual quaternion with coefficients of type @p OtherScalar.
+ */
+template<typename Scalar>
+template<typename OtherScalar>
+GenericDQ<OtherScalar> GenericDQ<Scalar>::cast() const
+{
+    return GenericDQ<OtherScalar>(q.template cast<OtherScalar>().eval());
+}
+
+/**
+ * @brief to_dq the same dual quaternion in double precision.
+ */
+template<typename Scalar>
+DQ GenericDQ<Scalar>::to_dq() const
+{
+    DQ dq;
+    for(int n = 0; n < 8; n++)
+        dq.q(n) = static_cast<double>(q(n));
+    return dq;
+}
+
+/**
+ * @brief apply_threshold rounds to zero the coefficients below DQ_ScalarTraits<Scalar>::threshold().
+ */
+template<typename Scalar>
+void GenericDQ<Scalar>::apply_threshold()
+{
+    for(int n = 0; n < 8; n++)
+        DQ_ScalarTraits<Scalar>::apply_threshold(q(n));
+}
+
+/* **********************************************************************
+ *  OPERATORS
+ * *********************************************************************/
+
+/*
+ * The operators are small enough to be inlined at every call site, so they are not part of the explicit
+ * instantiations. The scalar of a scaling is not deduced, so 0.5*x also works for GenericDQ<float>.
+ */
+
+template<typename Scalar>
+GenericDQ<Scalar> operator+(const GenericDQ<Scalar>& dq1, const GenericDQ<Scalar>& dq2)
+{
+    GenericDQ<Scalar> r(Matrix<Scalar,8,1>(dq1.q + dq2.q));
+    r.apply_threshold();
+    return r;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> operator-(const GenericDQ<Scalar>& dq1, const GenericDQ<Scalar>& dq2)
+{
+    GenericDQ<Scalar> r(Matrix<Scalar,8,1>(dq1.q - dq2.q));
+    r.apply_threshold();
+    return r;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> operator-(const GenericDQ<Scalar>& dq)
+{
+    return GenericDQ<Scalar>(Matrix<Scalar,8,1>(-dq.q));
+}
+
+/**
+ * The dual quaternion product, with the same kernel as DQ's operator*.
+ */
+template<typename Scalar>
+GenericDQ<Scalar> operator*(const GenericDQ<Scalar>& dq1, const GenericDQ<Scalar>& dq2)
+{
+    GenericDQ<Scalar> r;
+    dq_kernels::product(dq1.q.data(), dq2.q.data(), r.q.data());
+    r.apply_threshold();
+    return r;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> operator*(const typename GenericDQ<Scalar>::scalar_type& a, const GenericDQ<Scalar>& dq)
+{
+    GenericDQ<Scalar> r(Matrix<Scalar,8,1>(a*dq.q));
+    r.apply_threshold();
+    return r;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> operator*(const GenericDQ<Scalar>& dq, const typename GenericDQ<Scalar>::scalar_type& a)
+{
+    return a*dq;
+}
+
+/**
+ * Coefficient-wise comparison with the tolerance DQ_ScalarTraits<Scalar>::threshold(), as DQ's operator== does with
+ * DQ_threshold, so that GenericDQ<double> and DQ agree. Scalars without a threshold are compared exactly.
+ */
+template<typename Scalar>
+bool operator==(const GenericDQ<Scalar>& dq1, const GenericDQ<Scalar>& dq2)
+{
+    using std::fabs;
+    for(int n = 0; n < 8; n++)
+    {
+        if(fabs(dq1.q(n) - dq2.q(n)) > DQ_ScalarTraits<Scalar>::threshold())
+            return false;
+    }
+    return true;
+}
+
+template<typename Scalar>
+bool operator!=(const GenericDQ<Scalar>& dq1, const GenericDQ<Scalar>& dq2)
+{
+    return !(dq1 == dq2);
+}
+
+template<typename Scalar>
+std::ostream& operator<<(std::ostream& os, const GenericDQ<Scalar>& dq)
+{
+    return os << dq.to_dq();
+}
+
+/* **********************************************************************
+ *  PUBLIC METHODS
+ * *********************************************************************/
+
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::P() const
+{
+    return GenericDQ(q(0), q(1), q(2), q(3));
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::D() const
+{
+    return GenericDQ(q(4), q(5), q(6), q(7));
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::Re() const
+{
+    return GenericDQ(q(0), Scalar(0), Scalar(0), Scalar(0), q(4));
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::Im() const
+{
+    return GenericDQ(Scalar(0), q(1), q(2), q(3), Scalar(0), q(5), q(6), q(7));
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::conj() const
+{
+    return GenericDQ(q(0), -q(1), -q(2), -q(3), q(4), -q(5), -q(6), -q(7));
+}
+
+/**
+ * @brief norm the dual number |P| + E*dot(P,D)/|P|, the same as DQ::norm().
+ */
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::norm() const
+{
+    using std::sqrt;
+    const Scalar primary = sqrt(q(0)*q(0) + q(1)*q(1) + q(2)*q(2) + q(3)*q(3));
+    if(primary == Scalar(0))
+        return GenericDQ();
+    const Scalar dual = (q(0)*q(4) + q(1)*q(5) + q(2)*q(6) + q(3)*q(7))/primary;
+    return GenericDQ(primary, Scalar(0), Scalar(0), Scalar(0), dual);
+}
+
+/**
+ * @brief inv conj()*(1/a - E*b/a^2), where a + E*b = (*this)*conj() is a dual number.
+ */
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::inv() const
+{
+    const Scalar a = q(0)*q(0) + q(1)*q(1) + q(2)*q(2) + q(3)*q(3);
+    const Scalar b = Scalar(2)*(q(0)*q(4) + q(1)*q(5) + q(2)*q(6) + q(3)*q(7));
+    const Scalar inv_a = Scalar(1)/a;
+    return conj()*GenericDQ(inv_a, Scalar(0), Scalar(0), Scalar(0), -b*inv_a*inv_a);
+}
+
+/**
+ * @brief translation 2*D*conj(P), for a unit dual quaternion.
+ */
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::translation() const
+{
+    GenericDQ t;
+    dq_kernels::quaternion_times_conj(q.data()+4, q.data(), t.q.data());
+    t.q.template head<4>() *= Scalar(2);
+    t.apply_threshold();
+    return t;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::rotation() const
+{
+    return P();
+}
+
+/**
+ * @brief log the logarithm of a unit dual quaternion, as DQ::log_unchecked().
+ */
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::log() const
+{
+    GenericDQ log;
+    dq_kernels::log(q.data(), log.q.data());
+    log.apply_threshold();
+    return log;
+}
+
+/**
+ * @brief exp the exponential of a pure dual quaternion, as DQ::exp_unchecked(). The real part is ignored.
+ */
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::exp() const
+{
+    GenericDQ exp;
+    dq_kernels::exp(q.data(), exp.q.data());
+    exp.apply_threshold();
+    return exp;
+}
+
+/**
+ * @brief pow exp(a*log()) of a unit dual quaternion, in closed form as DQ::pow_unchecked().
+ */
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::pow(const Scalar& a) const
+{
+    GenericDQ pow;
+    dq_kernels::pow(q.data(), a, pow.q.data());
+    pow.apply_threshold();
+    return pow;
+}
+
+/**
+ * @brief normalize (*this)*inv(norm()), evaluated as P/|P| + E*(D/|P| - P*dot(P,D)/|P|^3).
+ */
+template<typename Scalar>
+GenericDQ<Scalar> GenericDQ<Scalar>::normalize() const
+{
+    using std::sqrt;
+    const Scalar squared_primary = q(0)*q(0) + q(1)*q(1) + q(2)*q(2) + q(3)*q(3);
+    const Scalar inv_primary = Scalar(1)/sqrt(squared_primary);
+    const Scalar dot = (q(0)*q(4) + q(1)*q(5) + q(2)*q(6) + q(3)*q(7))/squared_primary;
+
+    GenericDQ r;
+    r.q.template head<4>() = inv_primary*q.template head<4>();
+    r.q.template tail<4>() = inv_primary*(q.template tail<4>() - dot*q.template head<4>());
+    r.apply_threshold();
+    return r;
+}
+
+template<typename Scalar>
+typename GenericDQ<Scalar>::Vector4 GenericDQ<Scalar>::vec4() const
+{
+    return q.template head<4>();
+}
+
+template<typename Scalar>
+typename GenericDQ<Scalar>::Vector8 GenericDQ<Scalar>::vec8() const
+{
+    return q;
+}
+
+/**
+ * @brief hamiplus8 the matrix H such that vec8((*this)*dq) = H*vec8(dq).
+ */
+template<typename Scalar>
+Matrix<Scalar,8,8> GenericDQ<Scalar>::hamiplus8() const
+{
+    Matrix<Scalar,4,4> primary;
+    primary << q(0), -q(1), -q(2), -q(3),
+               q(1),  q(0), -q(3),  q(2),
+               q(2),  q(3),  q(0), -q(1),
+               q(3), -q(2),  q(1),  q(0);
+    Matrix<Scalar,4,4> dual;
+    dual << q(4), -q(5), -q(6), -q(7),
+            q(5),  q(4), -q(7),  q(6),
+            q(6),  q(7),  q(4), -q(5),
+            q(7), -q(6),  q(5),  q(4);
+
+    Matrix<Scalar,8,8> H;
+    H << primary, Matrix<Scalar,4,4>::Zero(),
+         dual,    primary;
+    return H;
+}
+
+/**
+ * @brief haminus8 the matrix H such that vec8(dq*(*this)) = H*vec8(dq).
+ */
+template<typename Scalar>
+Matrix<Scalar,8,8> GenericDQ<Scalar>::haminus8() const
+{
+    Matrix<Scalar,4,4> primary;
+    primary << q(0), -q(1), -q(2), -q(3),
+               q(1),  q(0),  q(3), -q(2),
+               q(2), -q(3),  q(0),  q(1),
+               q(3),  q(2), -q(1),  q(0);
+    Matrix<Scalar,4,4> dual;
+    dual << q(4), -q(5), -q(6), -q(7),
+            q(5),  q(4),  q(7), -q(6),
+            q(6), -q(7),  q(4),  q(5),
+            q(7),  q(6), -q(5),  q(4);
+
+    Matrix<Scalar,8,8> H;
+    H << primary, Matrix<Scalar,4,4>::Zero(),
+         dual,    primary;
+    return H;
+}
+
+/* **********************************************************************
+ *  NAMESPACE FUNCTIONS
+ * *********************************************************************/
+
+template<typename Scalar> GenericDQ<Scalar> P(const GenericDQ<Scalar>& dq)           { return dq.P(); }
+template<typename Scalar> GenericDQ<Scalar> D(const GenericDQ<Scalar>& dq)           { return dq.D(); }
+template<typename Scalar> GenericDQ<Scalar> Re(const GenericDQ<Scalar>& dq)          { return dq.Re(); }
+template<typename Scalar> GenericDQ<Scalar> Im(const GenericDQ<Scalar>& dq)          { return dq.Im(); }
+template<typename Scalar> GenericDQ<Scalar> conj(const GenericDQ<Scalar>& dq)        { return dq.conj(); }
+template<typename Scalar> GenericDQ<Scalar> norm(const GenericDQ<Scalar>& dq)        { return dq.norm(); }
+template<typename Scalar> GenericDQ<Scalar> inv(const GenericDQ<Scalar>& dq)         { return dq.inv(); }
+template<typename Scalar> GenericDQ<Scalar> translation(const GenericDQ<Scalar>& dq) { return dq.translation(); }
+template<typename Scalar> GenericDQ<Scalar> rotation(const GenericDQ<Scalar>& dq)    { return dq.rotation(); }
+template<typename Scalar> GenericDQ<Scalar> log(const GenericDQ<Scalar>& dq)         { return dq.log(); }
+template<typename Scalar> GenericDQ<Scalar> exp(const GenericDQ<Scalar>& dq)         { return dq.exp(); }
+template<typename Scalar> GenericDQ<Scalar> normalize(const GenericDQ<Scalar>& dq)   { return dq.normalize(); }
+template<typename Scalar> Matrix<Scalar,4,1> vec4(const GenericDQ<Scalar>& dq)       { return dq.vec4(); }
+template<typename Scalar> Matrix<Scalar,8,1> vec8(const GenericDQ<Scalar>& dq)       { return dq.vec8(); }
+template<typename Scalar> Matrix<Scalar,8,8> hamiplus8(const GenericDQ<Scalar>& dq)  { return dq.hamiplus8(); }
+template<typename Scalar> Matrix<Scalar,8,8> haminus8(const GenericDQ<Scalar>& dq)   { return dq.haminus8(); }
+
+template<typename Scalar>
+GenericDQ<Scalar> pow(const GenericDQ<Scalar>& dq, const typename GenericDQ<Scalar>::scalar_type& a)
+{
+    return dq.pow(a);
+}
+
+/**
+ * The adjoint transformation dq1*dq2*conj(dq1), for a unit @p dq1.
+ */
+template<typename Scalar>
+GenericDQ<Scalar> Ad(const GenericDQ<Scalar>& dq1, const GenericDQ<Scalar>& dq2)
+{
+    return dq1*dq2*dq1.conj();
+}
+
+extern template class GenericDQ<float>;
+extern template class GenericDQ<double>;
+
+}
+
+#endif
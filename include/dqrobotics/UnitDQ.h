@@ -0,0 +1,96 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_UNITDQ_H
+#define DQ_ROBOTICS_UNITDQ_H
+
+#include<dqrobotics/DQ.h>
+
+namespace DQ_robotics
+{
+
+/**
+ * A unit dual quaternion, i.e. a rigid-body pose.
+ *
+ * The constructor normalizes its argument once. From then on the type carries the guarantee, so inv() is conj() and
+ * log(), pow(), translation(), rotation(), Ad(), and tplus() skip the unit-norm validation of their DQ counterparts.
+ * Products and conjugates of UnitDQs are UnitDQs. UnitDQ is a DQ, so it can be passed wherever a DQ is expected, and
+ * any other operation, e.g. a sum, returns a plain DQ.
+ *
+ * q is inherited as a public member; writing to it directly voids the guarantee.
+ */
+class UnitDQ: public DQ
+{
+private:
+    struct Unchecked {};
+    UnitDQ(const DQ& dq, const Unchecked&);
+
+public:
+    UnitDQ();
+    explicit UnitDQ(const DQ& dq);
+
+    static UnitDQ unchecked(const DQ& dq);
+
+    UnitDQ conj() const;
+    UnitDQ inv() const;
+    UnitDQ rotation() const;
+    DQ     translation() const;
+    DQ     rotation_axis() const;
+    double rotation_angle() const;
+    DQ     log() const;
+    UnitDQ pow(const double a) const;
+    UnitDQ tplus() const;
+    DQ     Ad(const DQ& dq2) const;
+    DQ     Adsharp(const DQ& dq2) const;
+};
+
+UnitDQ operator*(const UnitDQ& dq1, const UnitDQ& dq2);
+
+UnitDQ conj(const UnitDQ& dq);
+
+UnitDQ inv(const UnitDQ& dq);
+
+UnitDQ rotation(const UnitDQ& dq);
+
+DQ translation(const UnitDQ& dq);
+
+DQ rotation_axis(const UnitDQ& dq);
+
+double rotation_angle(const UnitDQ& dq);
+
+DQ log(const UnitDQ& dq);
+
+UnitDQ unit_exp(const DQ& dq);
+
+UnitDQ pow(const UnitDQ& dq, const double& a);
+
+UnitDQ tplus(const UnitDQ& dq);
+
+DQ Ad(const UnitDQ& dq1, const DQ& dq2);
+
+DQ Adsharp(const UnitDQ& dq1, const DQ& dq2);
+
+UnitDQ normalize(const UnitDQ& dq);
+
+}//Namespace DQRobotics
+
+#endif // DQ_ROBOTICS_UNITDQ_H
@@ -0,0 +1,102 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_ROBOT_CONTROL_DQ_QUADRATICPROGRAMMINGCONTROLLER
+#define DQ_ROBOTICS_ROBOT_CONTROL_DQ_QUADRATICPROGRAMMINGCONTROLLER
+
+#include<dqrobotics/DQ.h>
+#include<dqrobotics/robot_modeling/DQ_SerialManipulator.h>
+#include<dqrobotics/solvers/DQ_QuadraticProgrammingSolver.h>
+
+namespace DQ_robotics
+{
+
+/**
+ * Differential inverse kinematics controller with linear constraints on the joint velocities.
+ *
+ * Each call to compute_setpoint_control_signal() returns the joint velocities u that solve
+ *
+ *     min_u 0.5*||J*u + gain*e||^2 + 0.5*damping*||u||^2  subject to  A*u <= b,  Aeq*u = beq,  lower <= u <= upper,
+ *
+ * where e is the difference between the task variable and its reference and J is the task Jacobian. The inequality
+ * constraints are meant to be built at every control tick from the distance Jacobians and residuals of DQ_Kinematics,
+ * e.g. -point_to_plane_distance_jacobian(...)*u <= eta*(d - d_safe), and set with set_inequality_constraint().
+ *
+ * The quadratic program is solved by any DQ_QuadraticProgrammingSolver, e.g. DQ_ActiveSetQuadraticProgrammingSolver,
+ * which keeps its workspace and hot-starts from the previous tick. The robot and the solver must outlive the
+ * controller.
+ */
+class DQ_QuadraticProgrammingController
+{
+public:
+    enum class ControlObjective { pose, translation, rotation, distance };
+
+private:
+    const DQ_SerialManipulator*     robot_;
+    DQ_QuadraticProgrammingSolver*  solver_;
+
+    ControlObjective control_objective_;
+    double           gain_;
+    double           damping_;
+
+    MatrixXd inequality_matrix_;
+    VectorXd inequality_vector_;
+    MatrixXd equality_matrix_;
+    VectorXd equality_vector_;
+    VectorXd lower_joint_velocity_limits_;
+    VectorXd upper_joint_velocity_limits_;
+
+    //Workspace
+    MatrixXd pose_jacobian_;
+    MatrixXd task_jacobian_;
+    VectorXd task_variable_;
+    VectorXd task_error_;
+    MatrixXd H_;
+    VectorXd f_;
+    MatrixXd A_;
+    VectorXd b_;
+
+    void update_task_(const VectorXd& q);
+public:
+    DQ_QuadraticProgrammingController(const DQ_SerialManipulator& robot, DQ_QuadraticProgrammingSolver& solver);
+
+    void             set_control_objective(const ControlObjective& control_objective);
+    ControlObjective control_objective() const;
+    void             set_gain(const double& gain);
+    double           gain() const;
+    void             set_damping(const double& damping);
+    double           damping() const;
+
+    void set_inequality_constraint(const MatrixXd& A, const VectorXd& b);
+    void set_equality_constraint(const MatrixXd& Aeq, const VectorXd& beq);
+    void set_joint_velocity_limits(const VectorXd& lower, const VectorXd& upper);
+    void clear_constraints();
+
+    VectorXd get_task_variable(const VectorXd& q);
+    MatrixXd get_jacobian(const VectorXd& q);
+    VectorXd compute_setpoint_control_signal(const VectorXd& q, const VectorXd& task_reference);
+    const VectorXd& last_task_error() const;
+};
+
+}
+
+#endif
@@ -38,14 +38,14 @@ private:
 public:
     DQ_CooperativeDualTaskSpace(DQ_Kinematics* robot1, DQ_Kinematics* robot2);
 
-    DQ pose1(const VectorXd& theta);
-    DQ pose2(const VectorXd& theta);
+    UnitDQ pose1(const VectorXd& theta);
+    UnitDQ pose2(const VectorXd& theta);
 
     MatrixXd pose_jacobian1(const VectorXd& theta);
     MatrixXd pose_jacobian2(const VectorXd& theta);
 
-    DQ relative_pose(const VectorXd& theta);
-    DQ absolute_pose(const VectorXd& theta);
+    UnitDQ relative_pose(const VectorXd& theta);
+    UnitDQ absolute_pose(const VectorXd& theta);
 
     MatrixXd relative_pose_jacobian(const VectorXd& theta);
     MatrixXd absolute_pose_jacobian(const VectorXd& theta);
@@ -0,0 +1,344 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOT_MODELLING_DQ_DHKERNELS_H
+#define DQ_ROBOT_MODELLING_DQ_DHKERNELS_H
+
+#include<dqrobotics/utils/DQ_CoefficientKernels.h>
+
+#include<eigen3/Eigen/Dense>
+#include<algorithm>
+#include<cmath>
+
+using namespace Eigen;
+
+/**
+ * The Denavit-Hartenberg kernels shared by DQ_SerialManipulator, DQ_FixedSerialManipulator, and
+ * DQ_GenericSerialManipulator: the pose of a link, the axis of a joint, the sweep through the chain of fkm and of the
+ * pose Jacobian, and the sweep of batch_fkm(). They work on raw coefficients of any scalar type and, like those of
+ * DQ_CoefficientKernels.h, apply no threshold.
+ */
+namespace DQ_robotics
+{
+
+enum class DQ_DHConvention { standard, modified };
+
+/**
+ * The per-link quantities derived from a column of a DH matrix, so that fkm and the Jacobians never re-read it.
+ */
+template<typename Scalar>
+struct DQ_DHLinkParameters
+{
+    Scalar theta;
+    Scalar d2;           //d/2
+    Scalar a2;           //a/2
+    Scalar cos_alpha2;   //cos(alpha/2)
+    Scalar sin_alpha2;   //sin(alpha/2)
+    Scalar a_cos_alpha;  //a*cos(alpha), used by the modified convention Jacobian
+    Scalar a_sin_alpha;  //a*sin(alpha), used by the modified convention Jacobian
+    Scalar cos_alpha;
+    Scalar sin_alpha;
+    int    joint_index;  //Index of this link's joint in the joint vector, -1 for dummy joints
+};
+
+namespace dh_kernels
+{
+
+//batch_fkm() evaluates this many configurations at a time, in arrays that fit in the stack and in the L1 cache.
+const int BATCH_BLOCK_SIZE = 64;
+
+//A block of dual quaternions in structure-of-arrays layout: column k holds coefficient k of every sample.
+template<typename Scalar> using DQBlock     = Array<Scalar,Dynamic,8,ColMajor,BATCH_BLOCK_SIZE,8>;
+template<typename Scalar> using ScalarBlock = Array<Scalar,Dynamic,1,ColMajor,BATCH_BLOCK_SIZE,1>;
+
+/**
+ * The parameters of one link, computed in double precision and then converted, so that the models of all scalar
+ * types have the same parameters up to the precision of the scalar.
+ */
+template<typename Scalar>
+DQ_DHLinkParameters<Scalar> link_parameters(const double& theta, const double& d, const double& a, const double& alpha, const int& joint_index)
+{
+    DQ_DHLinkParameters<Scalar> link;
+    link.theta       = Scalar(theta);
+    link.d2          = Scalar(d/2.0);
+    link.a2          = Scalar(a/2.0);
+    link.cos_alpha2  = Scalar(std::cos(alpha/2.0));
+    link.sin_alpha2  = Scalar(std::sin(alpha/2.0));
+    link.a_cos_alpha = Scalar(a*std::cos(alpha));
+    link.a_sin_alpha = Scalar(a*std::sin(alpha));
+    link.cos_alpha   = Scalar(std::cos(alpha));
+    link.sin_alpha   = Scalar(std::sin(alpha));
+    link.joint_index = joint_index;
+    return link;
+}
+
+/**
+ * The pose q of a link whose joint is at @p theta_ang, see DQ_SerialManipulator::dh2dq().
+ */
+template<typename Scalar>
+void dh2dq(const Scalar& theta_ang, const DQ_DHLinkParameters<Scalar>& link, const DQ_DHConvention& convention, Scalar* q)
+{
+    using std::cos;
+    using std::sin;
+
+    const Scalar half_theta = (theta_ang + link.theta)/Scalar(2);
+    const Scalar cos_theta2 = cos(half_theta);
+    const Scalar sin_theta2 = sin(half_theta);
+
+    const Scalar h1 = cos_theta2*link.cos_alpha2;
+    const Scalar h2 = cos_theta2*link.sin_alpha2;
+    const Scalar h3 = sin_theta2*link.sin_alpha2;
+    const Scalar h4 = sin_theta2*link.cos_alpha2;
+    const Scalar& d2 = link.d2;
+    const Scalar& a2 = link.a2;
+
+    if(convention == DQ_DHConvention::standard) {
+        q[0]= h1;
+        q[1]= h2;
+        q[2]= h3;
+        q[3]= h4;
+        q[4]= -d2*h4 - a2*h2;
+        q[5]= -d2*h3 + a2*h1;
+        q[6]=  d2*h2 + a2*h4;
+        q[7]=  d2*h1 - a2*h3;
+    }
+    else{
+        q[0]= h1;
+        q[1]= h2;
+        q[2]= -h3;
+        q[3]= h4;
+        q[4]=-d2*h4 - a2*h2;
+        q[5]=-d2*h3 + a2*h1;
+        q[6]=-(d2*h2 + a2*h4);
+        q[7]=d2*h1 - a2*h3;
+    }
+}
+
+/**
+ * The axis z = 0.5*x*k_*conj(x) of a joint of the standard convention, where x is the pose of the previous link.
+ */
+template<typename Scalar>
+void standard_joint_axis(const Scalar* x, Scalar* z)
+{
+    z[0] = Scalar(0);
+    z[1] = x[1]*x[3] + x[0]*x[2];
+    z[2] = x[2]*x[3] - x[0]*x[1];
+    z[3] = (x[3]*x[3] - x[2]*x[2] - x[1]*x[1] + x[0]*x[0])/Scalar(2);
+    z[4] = Scalar(0);
+    z[5] = x[1]*x[7] + x[5]*x[3] + x[0]*x[6] + x[4]*x[2];
+    z[6] = x[2]*x[7] + x[6]*x[3] - x[0]*x[5] - x[4]*x[1];
+    z[7] = x[3]*x[7] - x[2]*x[6] - x[1]*x[5] + x[0]*x[4];
+}
+
+/**
+ * The axis z = 0.5*x*w*conj(x) of a joint of the modified convention, where x is the pose of the previous link and
+ * w is the axis of the joint w.r.t. that link.
+ */
+template<typename Scalar>
+void modified_joint_axis(const Scalar* x, const DQ_DHLinkParameters<Scalar>& link, Scalar* z)
+{
+    const Scalar w[8]      = {Scalar(0), Scalar(0), -link.sin_alpha, link.cos_alpha,
+                              Scalar(0), Scalar(0), -link.a_cos_alpha, -link.a_sin_alpha};
+    const Scalar x_conj[8] = {x[0], -x[1], -x[2], -x[3], x[4], -x[5], -x[6], -x[7]};
+
+    Scalar x_w[8];
+    dq_kernels::product(x, w, x_w);
+    dq_kernels::product(x_w, x_conj, z);
+    for(int n = 0; n < 8; n++)
+        z[n] /= Scalar(2);
+}
+
+/**
+ * The raw pose x of link @p to_link, i.e. the product of the poses of the first to_link links, with the joints at
+ * @p q and dummy joints at zero. On the way, the axis of each joint w.r.t. the base is written to column joint_index
+ * of @p joint_axes and the raw pose of link i+1 to column i of @p link_poses.
+ * @param x receives the eight coefficients of the raw pose.
+ * @param joint_axes column-major 8 x (number of joints) coefficients whose columns are @p joint_axes_stride apart, or
+ * nullptr when only the pose is needed. The columns of joints after to_link are left untouched.
+ * @param link_poses column-major 8 x to_link coefficients whose columns are @p link_poses_stride apart, or nullptr.
+ */
+template<typename Scalar, typename JointsDerived>
+void raw_fkm_and_joint_axes(const DQ_DHLinkParameters<Scalar>* links, const int& to_link, const DQ_DHConvention& convention,
+                            const MatrixBase<JointsDerived>& q, Scalar* x,
+                            Scalar* joint_axes = nullptr, const Index& joint_axes_stride = 8,
+                            Scalar* link_poses = nullptr, const Index& link_poses_stride = 8)
+{
+    Scalar link_dq[8];
+    Scalar r[8];
+
+    std::fill(x, x+8, Scalar(0));
+    x[0] = Scalar(1);
+    for(int i = 0; i < to_link; i++)
+    {
+        const DQ_DHLinkParameters<Scalar>& link = links[i];
+
+        if(link.joint_index >= 0)
+        {
+            if(joint_axes)
+            {
+                Scalar* z = joint_axes + link.joint_index*joint_axes_stride;
+                if(convention == DQ_DHConvention::standard)
+                    standard_joint_axis(x, z);
+                else
+                    modified_joint_axis(x, link, z);
+            }
+            dh2dq(Scalar(q(link.joint_index)), link, convention, link_dq);
+        }
+        else
+            // Dummy joints don't contribute to the Jacobian
+            dh2dq(Scalar(0), link, convention, link_dq);
+
+        dq_kernels::product(x, link_dq, r);
+        std::copy(r, r+8, x);
+
+        if(link_poses)
+            std::copy(x, x+8, link_poses + i*link_poses_stride);
+    }
+}
+
+/**
+ * Turns, in place, the joint axes z_j written by raw_fkm_and_joint_axes() into the columns
+ * reference_frame*z_j*x_effector of the pose Jacobian.
+ * @param reference_frame the eight coefficients of the reference frame, or nullptr for the raw pose Jacobian.
+ * @param x_effector the eight coefficients of the raw pose, followed by the effector when it is taken into account.
+ * @param jacobian column-major 8 x n_joints coefficients whose columns are @p stride apart.
+ */
+template<typename Scalar>
+void joint_axes_to_pose_jacobian(const Scalar* reference_frame, const Scalar* x_effector, const int& n_joints,
+                                 Scalar* jacobian, const Index& stride = 8)
+{
+    Scalar r[8];
+    for(int j = 0; j < n_joints; j++)
+    {
+        Scalar* z = jacobian + j*stride;
+        if(reference_frame)
+        {
+            dq_kernels::product(reference_frame, z, r);
+            dq_kernels::product(r, x_effector, z);
+        }
+        else
+        {
+            std::copy(z, z+8, r);
+            dq_kernels::product(r, x_effector, z);
+        }
+    }
+}
+
+/**
+ * Sample-wise dual quaternion product r = a*b for two blocks in structure-of-arrays layout. Each line is a sequence of
+ * array operations over all samples of the block, which Eigen vectorizes.
+ */
+template<typename Scalar>
+void block_product(const DQBlock<Scalar>& a, const DQBlock<Scalar>& b, DQBlock<Scalar>& r)
+{
+    r.resize(a.rows(),8);
+    r.col(0) = a.col(0)*b.col(0) - a.col(1)*b.col(1) - a.col(2)*b.col(2) - a.col(3)*b.col(3);
+    r.col(1) = a.col(0)*b.col(1) + a.col(1)*b.col(0) + a.col(2)*b.col(3) - a.col(3)*b.col(2);
+    r.col(2) = a.col(0)*b.col(2) - a.col(1)*b.col(3) + a.col(2)*b.col(0) + a.col(3)*b.col(1);
+    r.col(3) = a.col(0)*b.col(3) + a.col(1)*b.col(2) - a.col(2)*b.col(1) + a.col(3)*b.col(0);
+
+    r.col(4) = (a.col(0)*b.col(4) - a.col(1)*b.col(5) - a.col(2)*b.col(6) - a.col(3)*b.col(7))
+             + (a.col(4)*b.col(0) - a.col(5)*b.col(1) - a.col(6)*b.col(2) - a.col(7)*b.col(3));
+    r.col(5) = (a.col(0)*b.col(5) + a.col(1)*b.col(4) + a.col(2)*b.col(7) - a.col(3)*b.col(6))
+             + (a.col(4)*b.col(1) + a.col(5)*b.col(0) + a.col(6)*b.col(3) - a.col(7)*b.col(2));
+    r.col(6) = (a.col(0)*b.col(6) - a.col(1)*b.col(7) + a.col(2)*b.col(4) + a.col(3)*b.col(5))
+             + (a.col(4)*b.col(2) - a.col(5)*b.col(3) + a.col(6)*b.col(0) + a.col(7)*b.col(1));
+    r.col(7) = (a.col(0)*b.col(7) + a.col(1)*b.col(6) - a.col(2)*b.col(5) + a.col(3)*b.col(4))
+             + (a.col(4)*b.col(3) + a.col(5)*b.col(2) - a.col(6)*b.col(1) + a.col(7)*b.col(0));
+}
+
+/**
+ * The poses reference_frame*raw_fkm(q)*effector of the columns q of @p joint_configurations, written to the columns
+ * of @p poses. The configurations are processed in blocks stored as structure of arrays, so that the trigonometric
+ * functions and the dual quaternion products are evaluated for a whole block of samples at a time.
+ * @param links the @p n_links links of the chain.
+ * @param reference_frame the eight coefficients of the reference frame.
+ * @param effector the eight coefficients of the effector.
+ * @param poses must be 8 x joint_configurations.cols().
+ */
+template<typename Scalar, typename JointsDerived, typename PosesDerived>
+void batch_fkm(const DQ_DHLinkParameters<Scalar>* links, const int& n_links, const DQ_DHConvention& convention,
+               const Scalar* reference_frame, const Scalar* effector,
+               const MatrixBase<JointsDerived>& joint_configurations, MatrixBase<PosesDerived>& poses)
+{
+    typedef Map<const Matrix<Scalar,1,8>> CoefficientRow;
+
+    const int n_samples = joint_configurations.cols();
+    const Scalar sign = (convention == DQ_DHConvention::standard) ? Scalar(1) : Scalar(-1);
+
+    DQBlock<Scalar> x, link_dq, r;
+    ScalarBlock<Scalar> cos_theta2, sin_theta2;
+    Matrix<Scalar,Dynamic,Dynamic,ColMajor,BATCH_BLOCK_SIZE,Dynamic> theta_block;
+    Scalar dummy_dq[8];
+
+    for(int start = 0; start < n_samples; start += BATCH_BLOCK_SIZE)
+    {
+        const int block_size = std::min(BATCH_BLOCK_SIZE, n_samples - start);
+
+        //One joint per column, so that each joint's samples are contiguous
+        theta_block = joint_configurations.middleCols(start,block_size).transpose();
+
+        x = CoefficientRow(reference_frame).replicate(block_size,1);
+
+        for(int i = 0; i < n_links; i++)
+        {
+            const DQ_DHLinkParameters<Scalar>& link = links[i];
+
+            if(link.joint_index < 0)
+            {
+                //Dummy joints are evaluated at zero, so they are the same for all samples
+                dh2dq(Scalar(0), link, convention, dummy_dq);
+                link_dq = CoefficientRow(dummy_dq).replicate(block_size,1);
+            }
+            else
+            {
+                const auto half_theta = (theta_block.col(link.joint_index).array() + link.theta)/Scalar(2);
+                cos_theta2 = half_theta.cos();
+                sin_theta2 = half_theta.sin();
+
+                link_dq.resize(block_size,8);
+                link_dq.col(0) = cos_theta2*link.cos_alpha2;
+                link_dq.col(1) = cos_theta2*link.sin_alpha2;
+                link_dq.col(2) = sign*sin_theta2*link.sin_alpha2;
+                link_dq.col(3) = sin_theta2*link.cos_alpha2;
+                //Dual part written in terms of the primary part, see dh2dq()
+                link_dq.col(4) = -link.d2*link_dq.col(3) - link.a2*link_dq.col(1);
+                link_dq.col(5) = -sign*link.d2*link_dq.col(2) + link.a2*link_dq.col(0);
+                link_dq.col(6) = sign*(link.d2*link_dq.col(1) + link.a2*link_dq.col(3));
+                link_dq.col(7) = link.d2*link_dq.col(0) - sign*link.a2*link_dq.col(2);
+            }
+            block_product(x, link_dq, r);
+            x.swap(r);
+        }
+
+        link_dq = CoefficientRow(effector).replicate(block_size,1);
+        block_product(x, link_dq, r);
+
+        poses.middleCols(start,block_size) = r.matrix().transpose();
+    }
+}
+
+}
+
+}
+
+#endif
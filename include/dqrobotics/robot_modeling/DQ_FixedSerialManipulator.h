@@ -0,0 +1,338 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOT_MODELLING_DQ_FIXEDSERIALMANIPULATOR_H
+#define DQ_ROBOT_MODELLING_DQ_FIXEDSERIALMANIPULATOR_H
+
+#include<dqrobotics/DQ.h>
+#include<dqrobotics/robot_modeling/DQ_DHKernels.h>
+#include<dqrobotics/robot_modeling/DQ_Kinematics.h>
+#include<dqrobotics/robot_modeling/DQ_SerialManipulator.h>
+#include<dqrobotics/utils/DQ_Validation.h>
+
+#include<cmath>
+#include<stdexcept>
+
+namespace DQ_robotics
+{
+
+/**
+ * A serial manipulator whose number of joints, number of links, and DH convention are known at compile time.
+ * The kinematics are the same as DQ_SerialManipulator, but the joint vectors and the Jacobians are fixed-size Eigen
+ * objects and the sweeps through the chain have compile-time trip counts, so the compiler unrolls them and nothing
+ * is allocated. The DQ_Kinematics interface is also implemented, so it can be used wherever a DQ_Kinematics is expected.
+ * @tparam DOF the number of joints.
+ * @tparam CONVENTION the DH convention.
+ * @tparam LINKS the number of links, which is larger than DOF when there are dummy joints.
+ *
+ * Example:
+ *     DQ_FixedSerialManipulator<7> kuka(KukaLw4Robot::kinematics());
+ *     DQ_FixedSerialManipulator<6,DQ_DHConvention::standard,7> comau(ComauSmartSixRobot::kinematics());
+ */
+template<int DOF, DQ_DHConvention CONVENTION = DQ_DHConvention::standard, int LINKS = DOF>
+class DQ_FixedSerialManipulator: public DQ_Kinematics
+{
+    static_assert(DOF > 0 && LINKS >= DOF, "DQ_FixedSerialManipulator needs at least one joint and at least DOF links");
+
+public:
+    typedef Matrix<double,DOF,1> JointVector;
+    typedef Matrix<double,8,DOF> PoseJacobian;
+
+private:
+    //Same per-link quantities as DQ_SerialManipulator
+    typedef DQ_DHLinkParameters<double> LinkParameters;
+
+    LinkParameters links_[LINKS];
+    DQ curr_effector_;
+
+    void set_dh_matrix_(const MatrixXd& dh_matrix);
+    int  n_joints_up_to_(const int& to_link) const;
+    DQ   raw_fkm_and_joint_axes_(const JointVector& q, const int& to_link, PoseJacobian& joint_axes) const;
+
+protected:
+    void batch_pose_jacobian_kernel_(const VectorXd& q, const int& to_link, MatrixXd& pose_jacobian) const;
+
+public:
+    DQ_FixedSerialManipulator(const MatrixXd& dh_matrix);
+    explicit DQ_FixedSerialManipulator(const DQ_SerialManipulator& robot);
+
+    DQ effector() const;
+    DQ set_effector(const DQ& new_effector);
+
+    DQ raw_fkm(const JointVector& q, const int& to_link = LINKS) const;
+    template<class Derived>
+    UnitDQ fkm(const MatrixBase<Derived>& q) const;
+    UnitDQ fkm(const JointVector& q, const int& to_link) const;
+
+    PoseJacobian raw_pose_jacobian(const JointVector& q) const;
+    PoseJacobian pose_jacobian(const JointVector& q) const;
+    UnitDQ       fkm_and_pose_jacobian(const JointVector& q, PoseJacobian& pose_jacobian) const;
+
+    //Virtual method overloads (DQ_Kinematics)
+    virtual int      get_dim_configuration_space() const;
+    virtual DQ       fkm(const VectorXd& q) const;
+    virtual UnitDQ   unit_fkm(const VectorXd& q) const;
+    virtual MatrixXd pose_jacobian(const VectorXd& q, const int& to_link) const;
+};
+
+/* **********************************************************************
+ *  CONSTRUCTORS
+ * *********************************************************************/
+
+/**
+ * @brief DQ_FixedSerialManipulator constructor from a DH matrix.
+ * @param dh_matrix a 4xLINKS or 5xLINKS matrix with rows theta, d, a, alpha and, optionally, dummy, as in DQ_SerialManipulator.
+ * @exception std::range_error if the size of @p dh_matrix or its number of dummy joints do not match the template parameters.
+ */
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::DQ_FixedSerialManipulator(const MatrixXd& dh_matrix)
+{
+    curr_effector_ = DQ(1);
+    set_dh_matrix_(dh_matrix);
+}
+
+/**
+ * @brief DQ_FixedSerialManipulator constructor from a DQ_SerialManipulator, whose DH parameters, reference frame,
+ * base frame, effector, and name are copied.
+ * @exception std::range_error if the convention, number of links, or number of joints of @p robot do not match
+ * the template parameters.
+ */
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::DQ_FixedSerialManipulator(const DQ_SerialManipulator& robot)
+{
+    const std::string convention = (CONVENTION == DQ_DHConvention::standard) ? "standard" : "modified";
+    if(robot.convention() != convention)
+    {
+        throw std::range_error("Bad DQ_FixedSerialManipulator(robot) call: robot uses the " + robot.convention() + " convention");
+    }
+
+    MatrixXd dh_matrix(5,robot.get_dim_configuration_space());
+    dh_matrix.row(0) = robot.theta().transpose();
+    dh_matrix.row(1) = robot.d().transpose();
+    dh_matrix.row(2) = robot.a().transpose();
+    dh_matrix.row(3) = robot.alpha().transpose();
+    dh_matrix.row(4) = robot.dummy().transpose();
+    set_dh_matrix_(dh_matrix);
+
+    curr_effector_ = robot.effector();
+    set_reference_frame(robot.reference_frame());
+    set_base_frame(robot.base_frame());
+    set_name(robot.name());
+}
+
+/* **********************************************************************
+ *  PRIVATE METHODS
+ * *********************************************************************/
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+void DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::set_dh_matrix_(const MatrixXd& dh_matrix)
+{
+    if((dh_matrix.rows() != 4 && dh_matrix.rows() != 5) || dh_matrix.cols() != LINKS)
+    {
+        throw std::range_error("Bad DQ_FixedSerialManipulator(dh_matrix) call: dh_matrix must be 4xLINKS or 5xLINKS");
+    }
+
+    int joint_index = 0;
+    for(int i = 0; i < LINKS; i++)
+    {
+        const bool dummy = (dh_matrix.rows() == 5 && dh_matrix(4,i) == 1);
+        links_[i] = dh_kernels::link_parameters<double>(dh_matrix(0,i), dh_matrix(1,i), dh_matrix(2,i), dh_matrix(3,i),
+                                                        dummy ? -1 : joint_index++);
+    }
+
+    if(joint_index != DOF)
+    {
+        throw std::range_error("Bad DQ_FixedSerialManipulator(dh_matrix) call: the number of non-dummy joints must be DOF");
+    }
+}
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+int DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::n_joints_up_to_(const int& to_link) const
+{
+    if(to_link < 0 || to_link > LINKS)
+    {
+        throw std::range_error("The argument to_link has to be between 0 and the number of links.");
+    }
+    int n_joints = 0;
+    for(int i = 0; i < to_link; i++)
+    {
+        if(links_[i].joint_index >= 0)
+            n_joints++;
+    }
+    return n_joints;
+}
+
+/**
+ * Sweeps through the first to_link links, storing the axis of each joint w.r.t. the base in its column of joint_axes,
+ * see dh_kernels::raw_fkm_and_joint_axes(). The convention is a compile-time constant, so its branches are folded
+ * when the kernel is inlined. Columns of joints after to_link are left untouched.
+ * @return the raw pose of link to_link.
+ */
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+DQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::raw_fkm_and_joint_axes_(const JointVector& q, const int& to_link, PoseJacobian& joint_axes) const
+{
+    DQ x;
+    dh_kernels::raw_fkm_and_joint_axes(links_, to_link, CONVENTION, q, x.q.data(), joint_axes.data());
+    return x;
+}
+
+/**
+ * Per-sample kernel of batch_pose_jacobian(), see DQ_Kinematics.
+ */
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+void DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::batch_pose_jacobian_kernel_(const VectorXd& q, const int& to_link, MatrixXd& pose_jacobian) const
+{
+    if(q.size() != DOF)
+    {
+        throw std::range_error("Bad pose_jacobian(q,to_link) call: Incorrect number of joint variables");
+    }
+    PoseJacobian J;
+    const DQ x = raw_fkm_and_joint_axes_(q, to_link, J);
+    const DQ x_effector = (to_link == LINKS) ? x * curr_effector_ : x;
+
+    const int n_joints = n_joints_up_to_(to_link);
+    dh_kernels::joint_axes_to_pose_jacobian(reference_frame_.q.data(), x_effector.q.data(), n_joints, J.data());
+    pose_jacobian = J.leftCols(n_joints);
+}
+
+/* **********************************************************************
+ *  PUBLIC METHODS
+ * *********************************************************************/
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+DQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::effector() const
+{
+    return curr_effector_;
+}
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+DQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::set_effector(const DQ& new_effector)
+{
+    if(DQROBOTICS_INPUT_VALIDATION && !is_unit(new_effector))
+    {
+        throw std::range_error("Bad set_effector(new_effector) call: Not a unit dual quaternion");
+    }
+    curr_effector_ = new_effector;
+    return curr_effector_;
+}
+
+/**
+ * @brief raw_fkm the pose of link @p to_link, without the reference frame and the effector.
+ */
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+DQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::raw_fkm(const JointVector& q, const int& to_link) const
+{
+    n_joints_up_to_(to_link);
+    DQ x;
+    dh_kernels::raw_fkm_and_joint_axes(links_, to_link, CONVENTION, q, x.q.data());
+    return x;
+}
+
+/**
+ * @brief fkm the pose of the effector w.r.t. the reference frame.
+ * @param q any Eigen vector of DOF joint variables, e.g. a JointVector, a VectorXd, or an expression such as
+ * VectorXd::Zero(DOF). A single template overload, so these calls do not have to choose between a conversion to
+ * JointVector and one to the VectorXd of DQ_Kinematics::fkm.
+ * @exception std::range_error if @p q does not have DOF entries.
+ */
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+template<class Derived>
+UnitDQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::fkm(const MatrixBase<Derived>& q) const
+{
+    if(q.size() != DOF)
+    {
+        throw std::range_error("Bad fkm(q) call: Incorrect number of joint variables");
+    }
+    return UnitDQ::unchecked(reference_frame_ * raw_fkm(JointVector(q)) * curr_effector_);
+}
+
+/**
+ * @brief fkm the pose of link @p to_link w.r.t. the reference frame, followed by the effector as in DQ_SerialManipulator::fkm(theta_vec,ith).
+ */
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+UnitDQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::fkm(const JointVector& q, const int& to_link) const
+{
+    return UnitDQ::unchecked(reference_frame_ * raw_fkm(q, to_link) * curr_effector_);
+}
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+typename DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::PoseJacobian
+DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::raw_pose_jacobian(const JointVector& q) const
+{
+    PoseJacobian J;
+    const DQ x = raw_fkm_and_joint_axes_(q, LINKS, J);
+    dh_kernels::joint_axes_to_pose_jacobian<double>(nullptr, x.q.data(), DOF, J.data());
+    return J;
+}
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+typename DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::PoseJacobian
+DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::pose_jacobian(const JointVector& q) const
+{
+    PoseJacobian J;
+    fkm_and_pose_jacobian(q, J);
+    return J;
+}
+
+/**
+ * @brief fkm_and_pose_jacobian the pose of the effector and the pose Jacobian, in a single sweep through the chain.
+ * @param pose_jacobian receives the pose Jacobian.
+ * @return the same as fkm(q).
+ */
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+UnitDQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::fkm_and_pose_jacobian(const JointVector& q, PoseJacobian& pose_jacobian) const
+{
+    const DQ x = raw_fkm_and_joint_axes_(q, LINKS, pose_jacobian);
+    const DQ x_effector = x * curr_effector_;
+    dh_kernels::joint_axes_to_pose_jacobian(reference_frame_.q.data(), x_effector.q.data(), DOF, pose_jacobian.data());
+    return UnitDQ::unchecked(reference_frame_ * x_effector);
+}
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+int DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::get_dim_configuration_space() const
+{
+    return LINKS;
+}
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+DQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::fkm(const VectorXd& q) const
+{
+    return fkm<VectorXd>(q);
+}
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+UnitDQ DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::unit_fkm(const VectorXd& q) const
+{
+    return fkm<VectorXd>(q);
+}
+
+template<int DOF, DQ_DHConvention CONVENTION, int LINKS>
+MatrixXd DQ_FixedSerialManipulator<DOF,CONVENTION,LINKS>::pose_jacobian(const VectorXd& q, const int& to_link) const
+{
+    MatrixXd J;
+    batch_pose_jacobian_kernel_(q, to_link, J);
+    return J;
+}
+
+}
+
+#endif
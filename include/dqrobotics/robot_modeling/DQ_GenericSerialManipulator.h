@@ -0,0 +1,307 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOT_MODELLING_DQ_GENERICSERIALMANIPULATOR_H
+#define DQ_ROBOT_MODELLING_DQ_GENERICSERIALMANIPULATOR_H
+
+#include<dqrobotics/GenericDQ.h>
+#include<dqrobotics/robot_modeling/DQ_DHKernels.h>
+#include<dqrobotics/robot_modeling/DQ_SerialManipulator.h>
+
+#include<stdexcept>
+#include<vector>
+
+namespace DQ_robotics
+{
+
+/**
+ * The kinematics of a DQ_SerialManipulator evaluated with scalars of type @p Scalar.
+ *
+ * The DH parameters, reference frame, and effector are copied from the DQ_SerialManipulator at construction, and the
+ * per-link sines and cosines are computed in double precision before being converted, so a float model has the
+ * same parameters, to float precision, as the double model. The per-link poses, the joint axes, and the batch sweep
+ * are the kernels of DQ_DHKernels.h, shared with DQ_SerialManipulator and DQ_FixedSerialManipulator.
+ *
+ * With Scalar = float, batch_fkm() processes twice as many samples per SIMD instruction as with double. The
+ * results carry about 1e-6 of relative error, so float suits sampling, collision checking, and visualization
+ * rather than control. The members are explicitly instantiated for float and double in the library.
+ *
+ * Example:
+ *     DQ_GenericSerialManipulator<float> kuka(KukaLw4Robot::kinematics());
+ *     GenericDQ<float> x = kuka.fkm(VectorXf::Constant(7,0.3f));
+ */
+template<typename Scalar>
+class DQ_GenericSerialManipulator
+{
+public:
+    typedef Matrix<Scalar,Dynamic,1>       JointVector;
+    typedef Matrix<Scalar,Dynamic,Dynamic> JointMatrix;
+    typedef Matrix<Scalar,8,Dynamic>       PoseJacobian;
+    typedef Matrix<Scalar,8,Dynamic>       PoseMatrix;
+
+private:
+    //Same per-link quantities as DQ_SerialManipulator
+    typedef DQ_DHLinkParameters<Scalar> LinkParameters;
+
+    std::vector<LinkParameters> links_;
+    int                         n_joints_;
+    DQ_DHConvention             convention_;
+    GenericDQ<Scalar>           reference_frame_;
+    GenericDQ<Scalar>           curr_effector_;
+
+    int               n_joints_up_to_(const int& to_link) const;
+    GenericDQ<Scalar> raw_fkm_and_joint_axes_(const Ref<const JointVector>& q, const int& to_link, PoseJacobian& joint_axes) const;
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    explicit DQ_GenericSerialManipulator(const DQ_SerialManipulator& robot);
+
+    int get_dim_configuration_space() const;
+    int get_dim_joints() const;
+
+    GenericDQ<Scalar> reference_frame() const;
+    void              set_reference_frame(const GenericDQ<Scalar>& reference_frame);
+    GenericDQ<Scalar> effector() const;
+    void              set_effector(const GenericDQ<Scalar>& effector);
+
+    GenericDQ<Scalar> raw_fkm(const Ref<const JointVector>& q) const;
+    GenericDQ<Scalar> raw_fkm(const Ref<const JointVector>& q, const int& to_link) const;
+    GenericDQ<Scalar> fkm(const Ref<const JointVector>& q) const;
+    GenericDQ<Scalar> fkm(const Ref<const JointVector>& q, const int& to_link) const;
+
+    PoseJacobian      pose_jacobian(const Ref<const JointVector>& q) const;
+    GenericDQ<Scalar> fkm_and_pose_jacobian(const Ref<const JointVector>& q, PoseJacobian& pose_jacobian) const;
+
+    PoseMatrix        batch_fkm(const JointMatrix& joint_configurations) const;
+};
+
+/* **********************************************************************
+ *  CONSTRUCTORS
+ * *********************************************************************/
+
+/**
+ * @brief DQ_GenericSerialManipulator constructor from a DQ_SerialManipulator, whose DH parameters, convention,
+ * reference frame, and effector are copied.
+ */
+template<typename Scalar>
+DQ_GenericSerialManipulator<Scalar>::DQ_GenericSerialManipulator(const DQ_SerialManipulator& robot):
+    n_joints_(0),
+    convention_(robot.convention() == "standard" ? DQ_DHConvention::standard : DQ_DHConvention::modified),
+    reference_frame_(robot.reference_frame()),
+    curr_effector_(robot.effector())
+{
+    const VectorXd theta = robot.theta();
+    const VectorXd d     = robot.d();
+    const VectorXd a     = robot.a();
+    const VectorXd alpha = robot.alpha();
+    const VectorXd dummy = robot.dummy();
+
+    links_.resize(robot.get_dim_configuration_space());
+    for(int i = 0; i < int(links_.size()); i++)
+    {
+        const bool is_dummy = (dummy.size() > i && dummy(i) == 1);
+        links_[i] = dh_kernels::link_parameters<Scalar>(theta(i), d(i), a(i), alpha(i), is_dummy ? -1 : n_joints_++);
+    }
+}
+
+/* **********************************************************************
+ *  PRIVATE METHODS
+ * *********************************************************************/
+
+template<typename Scalar>
+int DQ_GenericSerialManipulator<Scalar>::n_joints_up_to_(const int& to_link) const
+{
+    if(to_link < 0 || to_link > int(links_.size()))
+    {
+        throw std::range_error("The argument to_link has to be between 0 and the number of links.");
+    }
+    int n_joints = 0;
+    for(int i = 0; i < to_link; i++)
+    {
+        if(links_[i].joint_index >= 0)
+            n_joints++;
+    }
+    return n_joints;
+}
+
+/**
+ * Sweeps through the first to_link links, storing the axis of each joint w.r.t. the base in its column of joint_axes,
+ * see dh_kernels::raw_fkm_and_joint_axes().
+ * @return the raw pose of link to_link.
+ */
+template<typename Scalar>
+GenericDQ<Scalar> DQ_GenericSerialManipulator<Scalar>::raw_fkm_and_joint_axes_(const Ref<const JointVector>& q, const int& to_link, PoseJacobian& joint_axes) const
+{
+    GenericDQ<Scalar> x;
+    dh_kernels::raw_fkm_and_joint_axes(links_.data(), to_link, convention_, q, x.q.data(), joint_axes.data());
+    x.apply_threshold();
+    return x;
+}
+
+/* **********************************************************************
+ *  PUBLIC METHODS
+ * *********************************************************************/
+
+/**
+ * @brief get_dim_configuration_space the number of links, including those of dummy joints, as in DQ_SerialManipulator.
+ */
+template<typename Scalar>
+int DQ_GenericSerialManipulator<Scalar>::get_dim_configuration_space() const
+{
+    return int(links_.size());
+}
+
+/**
+ * @brief get_dim_joints the number of joint variables, i.e. the size of the joint vectors.
+ */
+template<typename Scalar>
+int DQ_GenericSerialManipulator<Scalar>::get_dim_joints() const
+{
+    return n_joints_;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> DQ_GenericSerialManipulator<Scalar>::reference_frame() const
+{
+    return reference_frame_;
+}
+
+template<typename Scalar>
+void DQ_GenericSerialManipulator<Scalar>::set_reference_frame(const GenericDQ<Scalar>& reference_frame)
+{
+    reference_frame_ = reference_frame;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> DQ_GenericSerialManipulator<Scalar>::effector() const
+{
+    return curr_effector_;
+}
+
+template<typename Scalar>
+void DQ_GenericSerialManipulator<Scalar>::set_effector(const GenericDQ<Scalar>& effector)
+{
+    curr_effector_ = effector;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> DQ_GenericSerialManipulator<Scalar>::raw_fkm(const Ref<const JointVector>& q) const
+{
+    return raw_fkm(q, get_dim_configuration_space());
+}
+
+/**
+ * @brief raw_fkm the pose of link @p to_link, without the reference frame and the effector.
+ */
+template<typename Scalar>
+GenericDQ<Scalar> DQ_GenericSerialManipulator<Scalar>::raw_fkm(const Ref<const JointVector>& q, const int& to_link) const
+{
+    if(int(q.size()) != n_joints_)
+    {
+        throw std::range_error("Bad raw_fkm(q,to_link) call: Incorrect number of joint variables");
+    }
+    n_joints_up_to_(to_link);
+
+    GenericDQ<Scalar> x;
+    dh_kernels::raw_fkm_and_joint_axes(links_.data(), to_link, convention_, q, x.q.data());
+    x.apply_threshold();
+    return x;
+}
+
+template<typename Scalar>
+GenericDQ<Scalar> DQ_GenericSerialManipulator<Scalar>::fkm(const Ref<const JointVector>& q) const
+{
+    return reference_frame_ * raw_fkm(q) * curr_effector_;
+}
+
+/**
+ * @brief fkm the pose of link @p to_link w.r.t. the reference frame, followed by the effector as in DQ_SerialManipulator::fkm(theta_vec,ith).
+ */
+template<typename Scalar>
+GenericDQ<Scalar> DQ_GenericSerialManipulator<Scalar>::fkm(const Ref<const JointVector>& q, const int& to_link) const
+{
+    return reference_frame_ * raw_fkm(q, to_link) * curr_effector_;
+}
+
+template<typename Scalar>
+typename DQ_GenericSerialManipulator<Scalar>::PoseJacobian
+DQ_GenericSerialManipulator<Scalar>::pose_jacobian(const Ref<const JointVector>& q) const
+{
+    PoseJacobian J;
+    fkm_and_pose_jacobian(q, J);
+    return J;
+}
+
+/**
+ * @brief fkm_and_pose_jacobian the pose of the effector and the pose Jacobian, in a single sweep through the chain.
+ * @param pose_jacobian receives the pose Jacobian, it is resized to 8 x get_dim_joints().
+ * @return the same as fkm(q).
+ */
+template<typename Scalar>
+GenericDQ<Scalar> DQ_GenericSerialManipulator<Scalar>::fkm_and_pose_jacobian(const Ref<const JointVector>& q, PoseJacobian& pose_jacobian) const
+{
+    if(int(q.size()) != n_joints_)
+    {
+        throw std::range_error("Bad fkm_and_pose_jacobian(q,pose_jacobian) call: Incorrect number of joint variables");
+    }
+    pose_jacobian.resize(8, n_joints_);
+
+    const GenericDQ<Scalar> x = raw_fkm_and_joint_axes_(q, get_dim_configuration_space(), pose_jacobian);
+    const GenericDQ<Scalar> x_effector = x * curr_effector_;
+    dh_kernels::joint_axes_to_pose_jacobian(reference_frame_.q.data(), x_effector.q.data(), n_joints_, pose_jacobian.data());
+    for(int n = 0; n < pose_jacobian.size(); n++)
+        DQ_ScalarTraits<Scalar>::apply_threshold(pose_jacobian.data()[n]);
+    return reference_frame_ * x_effector;
+}
+
+/**
+ * @brief batch_fkm the pose of the effector at each column of @p joint_configurations, as DQ_SerialManipulator::batch_fkm().
+ * The samples are processed in blocks, in structure-of-arrays layout, see dh_kernels::batch_fkm().
+ * @param joint_configurations has one configuration per column.
+ * @return vec8 of each pose, one per column.
+ */
+template<typename Scalar>
+typename DQ_GenericSerialManipulator<Scalar>::PoseMatrix
+DQ_GenericSerialManipulator<Scalar>::batch_fkm(const JointMatrix& joint_configurations) const
+{
+    if(int(joint_configurations.rows()) != n_joints_)
+    {
+        throw std::range_error("Bad batch_fkm(joint_configurations) call: Incorrect number of joint variables");
+    }
+
+    PoseMatrix poses(8,joint_configurations.cols());
+    dh_kernels::batch_fkm(links_.data(), get_dim_configuration_space(), convention_,
+                          reference_frame_.q.data(), curr_effector_.q.data(), joint_configurations, poses);
+
+    for(int n = 0; n < poses.size(); n++)
+        DQ_ScalarTraits<Scalar>::apply_threshold(poses.data()[n]);
+
+    return poses;
+}
+
+extern template class DQ_GenericSerialManipulator<float>;
+extern template class DQ_GenericSerialManipulator<double>;
+
+}
+
+#endif
@@ -39,6 +39,7 @@ public:
 
     //Virtual method overloads (DQ_Kinematics)
     virtual DQ fkm(const VectorXd& q) const;
+    virtual UnitDQ unit_fkm(const VectorXd& q) const;
     virtual MatrixXd pose_jacobian(const VectorXd& q, const int& to_link) const;
     virtual int get_dim_configuration_space() const;
 
@@ -0,0 +1,82 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_ROBOT_MODELING_DQ_INCREMENTALFKM
+#define DQ_ROBOTICS_ROBOT_MODELING_DQ_INCREMENTALFKM
+
+#include<dqrobotics/DQ.h>
+#include<dqrobotics/robot_modeling/DQ_SerialManipulator.h>
+#include<vector>
+
+namespace DQ_robotics
+{
+
+/**
+ * Stateful forward kinematics of a DQ_SerialManipulator for configurations that change a few joints at a time, e.g.
+ * in coordinate-descent inverse kinematics or when perturbing one joint for numerical checks.
+ *
+ * The evaluator keeps the last configuration, the transformation of each link, and the products of the links before
+ * (prefix) and after (suffix) each frame. When only the joints of links k..n change, only those link
+ * transformations and the prefixes from k on are recomputed. The suffixes are brought up to date lazily, when a
+ * *_with_joint() query needs them. The pose of every intermediate frame is a by-product of the prefixes.
+ *
+ * The robot must outlive the evaluator. Call reset() after changing its DH parameters or dummy joints; the reference
+ * frame and effector are read from the robot on every call and need no reset.
+ */
+class DQ_IncrementalFkm
+{
+private:
+    const DQ_SerialManipulator* robot_;
+
+    int n_links_;
+    std::vector<int> joint_index_;   //Per link, the index of its joint in the joint vector, -1 for dummy joints
+    std::vector<int> link_index_;    //Per joint, the index of its link
+
+    VectorXd theta_;
+    MatrixXd link_transforms_;       //8xlinks, column i is the transformation of link i+1
+    MatrixXd prefix_;                //8x(links+1), column i is the raw pose of link i, column 0 is 1
+    MatrixXd suffix_;                //8x(links+1), column i is the product of the links after link i, column links is 1
+    int      suffix_valid_from_;     //Columns of suffix_ from this one on are up to date
+    bool     initialized_;
+
+    void update_suffix_(const int& down_to);
+public:
+    explicit DQ_IncrementalFkm(const DQ_SerialManipulator& robot);
+
+    void reset();
+
+    int set_configuration(const VectorXd& theta_vec);
+    int set_joint(const int& joint, const double& value);
+    const VectorXd& configuration() const;
+
+    DQ raw_fkm() const;
+    DQ raw_fkm(const int& ith) const;
+    DQ fkm() const;
+    DQ fkm(const int& ith) const;
+
+    DQ raw_fkm_with_joint(const int& joint, const double& value);
+    DQ fkm_with_joint(const int& joint, const double& value);
+};
+
+}
+
+#endif
@@ -24,6 +24,7 @@ Contributors:
 #define DQ_ROBOT_MODELLING_DQ_KINEMATICS_H
 
 #include<dqrobotics/DQ.h>
+#include<dqrobotics/UnitDQ.h>
 
 namespace DQ_robotics
 {
@@ -35,7 +36,13 @@ protected:
     std::string name_;
     VectorXd q;
 
+    //Per-sample kernel of batch_pose_jacobian(), it is called concurrently and must not modify the robot
+    virtual void batch_pose_jacobian_kernel_(const VectorXd& joint_configurations, const int& to_link, MatrixXd& pose_jacobian) const;
+
 public:
+    //DQ members are fixed-size Eigen objects, so heap-allocated robots must be aligned
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
     //Constructor
     DQ_Kinematics();
 
@@ -55,6 +62,13 @@ public:
     virtual DQ       fkm(const VectorXd& joint_configurations) const = 0;
     virtual MatrixXd pose_jacobian(const VectorXd& joint_configurations,const int& to_link) const = 0;
 
+    //Virtual methods with a default implementation
+    virtual UnitDQ   unit_fkm(const VectorXd& joint_configurations) const;
+    virtual MatrixXd batch_fkm(const MatrixXd& joint_configurations) const;
+
+    //Concrete batch methods
+    MatrixXd batch_pose_jacobian(const MatrixXd& joint_configurations, const int& to_link, const int& number_of_threads = 0) const;
+
     ///Static methods
     static MatrixXd distance_jacobian(const MatrixXd& pose_jacobian, const DQ& pose);
     static MatrixXd translation_jacobian(const MatrixXd& pose_jacobian, const DQ& pose);
@@ -26,12 +26,14 @@ Contributors:
 
 #include <dqrobotics/DQ.h>
 #include <dqrobotics/robot_modeling/DQ_Kinematics.h>
+#include <dqrobotics/robot_modeling/DQ_DHKernels.h>
 
 #include <math.h>       //library for math functions
 #include <stdexcept>    //For range_error
 #include <eigen3/Eigen/Dense>  //Library for matrix usage
 #include <limits>       //Used in pseudoinverse()
 #include <string>
+#include <vector>
 
 using namespace Eigen;
 
@@ -50,13 +52,30 @@ private:
 
     DQ curr_effector_;
 
+    //Per-link quantities derived from dh_matrix_, so that fkm and the Jacobians never re-read it.
+    typedef DQ_DHLinkParameters<double> LinkParameters;
+
+    DQ_DHConvention             convention_;
+    std::vector<LinkParameters> links_;
+    int                         n_dummy_;
+
+    void update_link_parameters_();
+    int  n_joints_up_to_(const int& to_link) const;
+    DQ   dh2dq_(const double& theta_ang, const LinkParameters& link) const;
+    DQ   raw_fkm_and_joint_axes_(const VectorXd& theta_vec, const int& to_link, Ref<MatrixXd> joint_axes, Ref<MatrixXd>* link_poses) const;
+    DQ   raw_fkm_and_pose_jacobian_(const VectorXd& theta_vec, const int& to_link, Ref<MatrixXd> pose_jacobian, Ref<MatrixXd>* link_poses) const;
+    void raw_to_pose_jacobian_(const int& to_link, Ref<MatrixXd> pose_jacobian) const;
+
+protected:
+    void batch_pose_jacobian_kernel_(const VectorXd& theta_vec, const int& to_link, MatrixXd& pose_jacobian) const;
+
     // public methods
 public:
     // Class constructors: Creates a Dual Quaternion as a DQ object.
 
     DQ_SerialManipulator(const MatrixXd& dh_matrix, const std::string& convention = "standard" );
 
-    DQ_SerialManipulator(){}
+    DQ_SerialManipulator();
 
     MatrixXd getDHMatrix();
 
@@ -81,21 +100,40 @@ public:
     DQ raw_fkm( const VectorXd& theta_vec) const;
     DQ raw_fkm( const VectorXd& theta_vec, const int& ith) const;
 
-    DQ fkm( const VectorXd& theta_vec, const int& ith) const;
+    UnitDQ fkm( const VectorXd& theta_vec, const int& ith) const;
 
     DQ dh2dq( const double& theta_ang, const int& link_i) const;
 
-    DQ get_z( const VectorXd& q) const;
+    DQ get_z( const Ref<const VectorXd>& q) const;
 
     MatrixXd pose_jacobian           ( const VectorXd& theta_vec) const;
     MatrixXd raw_pose_jacobian       ( const VectorXd& theta_vec, const int& to_link) const;
     MatrixXd pose_jacobian_derivative( const VectorXd& theta_vec, const VectorXd& theta_vec_dot, const int& to_link) const;
 
+    //Overloads that write into preallocated memory and do not allocate
+    void pose_jacobian           ( const VectorXd& theta_vec, const int& to_link, Ref<MatrixXd> pose_jacobian) const;
+    void raw_pose_jacobian       ( const VectorXd& theta_vec, const int& to_link, Ref<MatrixXd> pose_jacobian) const;
+    void pose_jacobian_derivative( const VectorXd& theta_vec, const VectorXd& theta_vec_dot, const int& to_link, Ref<MatrixXd> pose_jacobian_derivative) const;
+
+    UnitDQ fkm_and_pose_jacobian( const VectorXd& theta_vec, MatrixXd& pose_jacobian) const;
+    UnitDQ fkm_and_pose_jacobian( const VectorXd& theta_vec, MatrixXd& pose_jacobian, MatrixXd& link_poses) const;
+    UnitDQ fkm_pose_jacobian_and_derivative( const VectorXd& theta_vec, const VectorXd& theta_vec_dot, MatrixXd& pose_jacobian, MatrixXd& pose_jacobian_derivative) const;
+
+    //Poses, and optionally pose Jacobians, of all links in one sweep
+    MatrixXd link_poses( const VectorXd& theta_vec) const;
+    void link_poses( const VectorXd& theta_vec, Ref<MatrixXd> link_poses) const;
+    void link_poses_and_jacobians( const VectorXd& theta_vec, Ref<MatrixXd> link_poses, Ref<MatrixXd> link_jacobians) const;
+
+    MatrixXd batch_fkm( const MatrixXd& theta_matrix) const;
+
     //Abstract methods' implementation
     int get_dim_configuration_space() const;
     MatrixXd pose_jacobian           ( const VectorXd& theta_vec, const int& to_link) const;
     DQ fkm( const VectorXd& theta_vec) const;
 
+    //Virtual methods' overloads
+    UnitDQ unit_fkm( const VectorXd& theta_vec) const;
+
 };
 
 }//Namespace DQRobotics
@@ -36,11 +36,12 @@ public:
     DQ_WholeBody(DQ_Kinematics *robot);
 
     void add(DQ_Kinematics* robot);
-    DQ fkm(const VectorXd& q, const int& to_chain) const;
+    UnitDQ fkm(const VectorXd& q, const int& to_chain) const;
 
     //Abstract methods' implementation
     int get_dim_configuration_space() const;
     DQ fkm(const VectorXd& q) const;
+    UnitDQ unit_fkm(const VectorXd& q) const;
     MatrixXd pose_jacobian(const VectorXd& q, const int& to_link) const;
 
 };
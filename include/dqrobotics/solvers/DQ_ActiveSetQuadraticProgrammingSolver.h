@@ -0,0 +1,111 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_SOLVERS_DQ_ACTIVESETQUADRATICPROGRAMMINGSOLVER
+#define DQ_ROBOTICS_SOLVERS_DQ_ACTIVESETQUADRATICPROGRAMMINGSOLVER
+
+#include<dqrobotics/solvers/DQ_QuadraticProgrammingSolver.h>
+
+namespace DQ_robotics
+{
+
+/**
+ * Dense quadratic programming solver for the small, strictly convex problems of differential kinematics, e.g. H =
+ * J^T*J + damping*I with tens of constraints.
+ *
+ * It implements the dual active-set method of Goldfarb and Idnani (1983), as in QuadProg++. Starting from the
+ * unconstrained minimum, it adds the violated constraints one at a time and drops the ones whose multipliers would
+ * become negative, so the solution is exact and the number of iterations is about the size of the final active set.
+ * H must be symmetric positive definite.
+ *
+ * All the memory is kept between calls and only reallocated when the size of the problem changes, so solve() does
+ * not allocate in a control loop. With hot start enabled, the default, the constraints that were active in the
+ * previous solve are added first when they are violated, which avoids most of the dropped constraints when
+ * consecutive problems are similar.
+ */
+class DQ_ActiveSetQuadraticProgrammingSolver: public DQ_QuadraticProgrammingSolver
+{
+public:
+    enum class Status { solved, infeasible, maximum_iterations };
+
+private:
+    int    maximum_iterations_;
+    bool   hot_start_;
+
+    Status status_;
+    int    iterations_;
+    double objective_value_;
+
+    //Workspace
+    LLT<MatrixXd> cholesky_;
+    MatrixXd J_;                 //L^-T, with H = L*L^T, rotated so that its last n - n_active_ columns span the null space of the active constraints
+    MatrixXd R_;                 //Upper triangular factor of the active constraints in the basis of J_
+    VectorXd x_;
+    VectorXd x_old_;
+    VectorXd d_;
+    VectorXd z_;                 //Primal step direction
+    VectorXd r_;                 //Dual step direction
+    VectorXd u_;                 //Multipliers of the active constraints
+    VectorXd u_old_;
+    VectorXd np_;                //Normal of the constraint being added
+    VectorXd slack_;             //b - A*x
+    VectorXi active_;            //Active constraints, equality i is stored as -i-1
+    VectorXi active_old_;
+    VectorXi inactive_;          //Per inequality, its index if it can be added, -1 if it is active
+    VectorXi eligible_;          //Per inequality, 0 if it was found to be linearly dependent on the active set
+    VectorXi previously_active_; //Per inequality, 1 if it was active at the end of the previous solve
+    int      n_active_;
+    double   r_norm_;
+
+    void resize_(const int& n, const int& m, const int& p);
+    void compute_step_directions_();
+    bool add_constraint_();
+    void delete_constraint_(const int& constraint, const int& n_equalities);
+    int  select_violated_constraint_() const;
+    Status finish_(const Status& status, const int& n_equalities);
+public:
+    DQ_ActiveSetQuadraticProgrammingSolver();
+
+    void   set_maximum_iterations(const int& maximum_iterations);
+    int    maximum_iterations() const;
+    void   set_hot_start(const bool& hot_start);
+    bool   hot_start() const;
+
+    Status solve(const MatrixXd& H, const VectorXd& f,
+                 const MatrixXd& A, const VectorXd& b,
+                 const MatrixXd& Aeq, const VectorXd& beq);
+
+    Status          status() const;
+    const VectorXd& solution() const;
+    double          objective_value() const;
+    int             iterations() const;
+    VectorXi        active_inequality_constraints() const;
+
+    //DQ_QuadraticProgrammingSolver
+    VectorXd solve_quadratic_program(const MatrixXd& H, const VectorXd& f,
+                                     const MatrixXd& A, const VectorXd& b,
+                                     const MatrixXd& Aeq, const VectorXd& beq) override;
+};
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_SOLVERS_DQ_INVERSEKINEMATICSSOLVER
+#define DQ_ROBOTICS_SOLVERS_DQ_INVERSEKINEMATICSSOLVER
+
+#include<dqrobotics/DQ.h>
+#include<dqrobotics/robot_modeling/DQ_SerialManipulator.h>
+
+namespace DQ_robotics
+{
+
+struct DQ_InverseKinematicsResult
+{
+    VectorXd joint_configuration;
+    bool     converged;
+    int      iterations;   //Number of linear solves, including rejected Levenberg-Marquardt steps
+    double   residual;     //Norm of the error at joint_configuration
+    double   time;         //Wall-clock time of the solve, in seconds
+};
+
+/**
+ * Iterative inverse kinematics of a DQ_SerialManipulator.
+ *
+ * Each iteration solves (J*J^T + lambda*I)*y = e and takes the step -J^T*y, where e is the 8-dimensional task error
+ * and J its Jacobian. With Method::damped_least_squares lambda is fixed and every step is taken. With
+ * Method::levenberg_marquardt a step is only taken if it decreases the error, lambda shrinks after an accepted step and
+ * grows after a rejected one.
+ *
+ * ErrorMetric::pose uses vec8(x - xd) and the pose Jacobian. ErrorMetric::log uses vec8(log(conj(xd)*x)), which weighs
+ * rotation and translation errors uniformly far from the solution, and approximates its Jacobian by that of
+ * conj(xd)*x, which is exact at the solution. In both cases the sign of xd is chosen so that x and xd are in the same
+ * hemisphere.
+ *
+ * The solver keeps its scratch memory between calls, so a solve does not allocate once the robot's number of joints is
+ * known. solve(xd) warm-starts from the previous solution. The robot must outlive the solver.
+ */
+class DQ_InverseKinematicsSolver
+{
+public:
+    enum class Method { damped_least_squares, levenberg_marquardt };
+    enum class ErrorMetric { pose, log };
+
+private:
+    const DQ_SerialManipulator* robot_;
+
+    Method      method_;
+    ErrorMetric error_metric_;
+    int         maximum_iterations_;
+    double      tolerance_;
+    double      step_tolerance_;
+    double      damping_;
+
+    DQ_InverseKinematicsResult result_;
+
+    //Scratch memory, reused by every solve
+    VectorXd q_trial_;
+    VectorXd step_;
+    MatrixXd pose_jacobian_;
+    MatrixXd pose_jacobian_trial_;
+    Matrix<double,8,1> error_;
+    Matrix<double,8,1> error_trial_;
+    Matrix<double,8,1> y_;
+    Matrix<double,8,8> damped_gram_;
+    LDLT<Matrix<double,8,8>> ldlt_;
+
+    double evaluate_(const VectorXd& q, const DQ& desired_pose, MatrixXd& jacobian, Matrix<double,8,1>& error) const;
+public:
+    //Fixed-size Eigen members, so heap-allocated solvers must be aligned
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    explicit DQ_InverseKinematicsSolver(const DQ_SerialManipulator& robot,
+                                        const Method& method = Method::levenberg_marquardt,
+                                        const ErrorMetric& error_metric = ErrorMetric::pose);
+
+    void        set_method(const Method& method);
+    Method      method() const;
+    void        set_error_metric(const ErrorMetric& error_metric);
+    ErrorMetric error_metric() const;
+    void        set_maximum_iterations(const int& maximum_iterations);
+    int         maximum_iterations() const;
+    void        set_tolerance(const double& tolerance);
+    double      tolerance() const;
+    void        set_step_tolerance(const double& step_tolerance);
+    double      step_tolerance() const;
+    void        set_damping(const double& damping);
+    double      damping() const;
+
+    const DQ_InverseKinematicsResult& solve(const DQ& desired_pose, const VectorXd& initial_configuration);
+    const DQ_InverseKinematicsResult& solve(const DQ& desired_pose);
+    const DQ_InverseKinematicsResult& result() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_SOLVERS_DQ_MULTISTARTINVERSEKINEMATICSSOLVER
+#define DQ_ROBOTICS_SOLVERS_DQ_MULTISTARTINVERSEKINEMATICSSOLVER
+
+#include<dqrobotics/solvers/DQ_InverseKinematicsSolver.h>
+#include<eigen3/Eigen/StdVector>
+#include<vector>
+
+namespace DQ_robotics
+{
+
+struct DQ_MultiStartInverseKinematicsResult
+{
+    MatrixXd solutions;      //One distinct solution per column, sorted by the index of the seed that found it
+    VectorXi seed_indexes;   //Per solution, the column of the seeds that found it
+    int      seeds_solved;   //Number of seeds that were solved, fewer than the number of seeds after an early stop
+    double   time;           //Wall-clock time of the search, in seconds
+};
+
+/**
+ * Searches for several inverse kinematics solutions of the same pose by solving from many seeds in parallel.
+ *
+ * Every seed is solved by a copy of a DQ_InverseKinematicsSolver, one per worker of parallel_for(), so all the settings
+ * of that solver apply. Converged solutions closer than the duplicate tolerance to a solution already found are
+ * discarded. Joint differences are wrapped to [-pi,pi], so configurations that differ by full turns are duplicates.
+ * When the maximum number of solutions is reached the remaining seeds are skipped.
+ *
+ * The solutions are the first distinct ones in seed order, so they do not depend on the number of threads or on the
+ * scheduling, with or without a maximum number of solutions. Only seeds_solved depends on the number of threads.
+ */
+class DQ_MultiStartInverseKinematicsSolver
+{
+private:
+    DQ_InverseKinematicsSolver solver_;
+    std::vector<DQ_InverseKinematicsSolver,aligned_allocator<DQ_InverseKinematicsSolver>> worker_solvers_;
+
+    int    number_of_threads_;
+    int    maximum_solutions_;
+    double duplicate_tolerance_;
+
+    DQ_MultiStartInverseKinematicsResult result_;
+
+    bool is_duplicate_(const Ref<const VectorXd>& a, const Ref<const VectorXd>& b) const;
+public:
+    explicit DQ_MultiStartInverseKinematicsSolver(const DQ_InverseKinematicsSolver& solver);
+
+    void   set_solver(const DQ_InverseKinematicsSolver& solver);
+    const DQ_InverseKinematicsSolver& solver() const;
+    void   set_number_of_threads(const int& number_of_threads);
+    int    number_of_threads() const;
+    void   set_maximum_solutions(const int& maximum_solutions);
+    int    maximum_solutions() const;
+    void   set_duplicate_tolerance(const double& duplicate_tolerance);
+    double duplicate_tolerance() const;
+
+    const DQ_MultiStartInverseKinematicsResult& solve(const DQ& desired_pose, const MatrixXd& seeds);
+    const DQ_MultiStartInverseKinematicsResult& result() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,51 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_ROBOTICS_SOLVERS_DQ_QUADRATICPROGRAMMINGSOLVER
+#define DQ_ROBOTICS_SOLVERS_DQ_QUADRATICPROGRAMMINGSOLVER
+
+#include<eigen3/Eigen/Dense>
+using namespace Eigen;
+
+namespace DQ_robotics
+{
+
+/**
+ * Interface of the quadratic programming solvers used by the constrained controllers, so that the bundled solver can
+ * be replaced by an external one.
+ */
+class DQ_QuadraticProgrammingSolver
+{
+public:
+    virtual ~DQ_QuadraticProgrammingSolver() = default;
+
+    /**
+     * Solves min_x 0.5*x^T*H*x + f^T*x subject to A*x <= b and Aeq*x = beq. A and Aeq can have zero rows.
+     */
+    virtual VectorXd solve_quadratic_program(const MatrixXd& H, const VectorXd& f,
+                                             const MatrixXd& A, const VectorXd& b,
+                                             const MatrixXd& Aeq, const VectorXd& beq) = 0;
+};
+
+}
+
+#endif
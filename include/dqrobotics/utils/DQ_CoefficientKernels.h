@@ -0,0 +1,185 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_UTILS_DQ_COEFFICIENTKERNELS_H
+#define DQ_UTILS_DQ_COEFFICIENTKERNELS_H
+
+#include<cmath>
+
+/**
+ * The dual quaternion algebra on raw coefficient arrays, shared by DQ, GenericDQ, and the lazy DQ expressions so that
+ * each operation is written once for every scalar type.
+ *
+ * Each kernel reads and writes eight (or four) contiguous coefficients in the order of DQ::q and applies no threshold,
+ * which is left to the caller. The output must not alias the inputs. Math functions are called unqualified, so those of user-defined scalars are found by
+ * argument-dependent lookup.
+ */
+namespace DQ_robotics
+{
+
+namespace dq_kernels
+{
+
+//Below this, the series expansions are used instead of the closed forms that divide by the angle
+template<typename Scalar> Scalar small_angle() { return Scalar(1e-6); }
+
+/**
+ * sin(x)/x.
+ */
+template<typename Scalar>
+Scalar sinc(const Scalar& x)
+{
+    using std::abs;
+    using std::sin;
+    if(abs(x) < small_angle<Scalar>())
+        return Scalar(1) - x*x/Scalar(6);
+    return sin(x)/x;
+}
+
+/**
+ * For a unit dq = cos(phi) + n*sin(phi) + E*(...), returns phi/sin(phi), so that the primary part of log(dq) is
+ * this times Im(P(dq)). @p im_norm is |Im(P(dq))|, which is sin(phi).
+ * When Im(P(dq)) is zero the axis is undefined and, as in rotation_axis(), the result is irrelevant.
+ */
+template<typename Scalar>
+Scalar angle_over_sin(const Scalar& re, const Scalar& im_norm)
+{
+    using std::atan2;
+    if(re > Scalar(0) && im_norm < small_angle<Scalar>())
+        return Scalar(1) + im_norm*im_norm/Scalar(6);
+    if(im_norm == Scalar(0))
+        return Scalar(0);
+    return atan2(im_norm, re)/im_norm;
+}
+
+/**
+ * The quaternion product r = a*b of the four coefficients starting at a and b.
+ */
+template<typename Scalar>
+void quaternion_times(const Scalar* a, const Scalar* b, Scalar* r)
+{
+    r[0] = a[0]*b[0] - a[1]*b[1] - a[2]*b[2] - a[3]*b[3];
+    r[1] = a[0]*b[1] + a[1]*b[0] + a[2]*b[3] - a[3]*b[2];
+    r[2] = a[0]*b[2] - a[1]*b[3] + a[2]*b[0] + a[3]*b[1];
+    r[3] = a[0]*b[3] + a[1]*b[2] - a[2]*b[1] + a[3]*b[0];
+}
+
+/**
+ * The quaternion product r = a*conj(b) of the four coefficients starting at a and b.
+ */
+template<typename Scalar>
+void quaternion_times_conj(const Scalar* a, const Scalar* b, Scalar* r)
+{
+    r[0] =  a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3];
+    r[1] = -a[0]*b[1] + a[1]*b[0] - a[2]*b[3] + a[3]*b[2];
+    r[2] = -a[0]*b[2] + a[1]*b[3] + a[2]*b[0] - a[3]*b[1];
+    r[3] = -a[0]*b[3] - a[1]*b[2] + a[2]*b[1] + a[3]*b[0];
+}
+
+/**
+ * The dual quaternion product r = a*b, that is, P(a)*P(b) + E*(P(a)*D(b) + D(a)*P(b)).
+ */
+template<typename Scalar>
+void product(const Scalar* a, const Scalar* b, Scalar* r)
+{
+    Scalar primary_dual[4];
+    Scalar dual_primary[4];
+    quaternion_times(a, b, r);
+    quaternion_times(a, b+4, primary_dual);
+    quaternion_times(a+4, b, dual_primary);
+    for(int n = 0; n < 4; n++)
+        r[n+4] = primary_dual[n] + dual_primary[n];
+}
+
+/**
+ * The logarithm r of the unit dual quaternion x, (phi/sin(phi))*Im(P) + E*D*conj(P).
+ */
+template<typename Scalar>
+void log(const Scalar* x, Scalar* r)
+{
+    using std::sqrt;
+    const Scalar coefficient = angle_over_sin(x[0], sqrt(x[1]*x[1] + x[2]*x[2] + x[3]*x[3]));
+
+    r[0] = Scalar(0);
+    r[1] = coefficient*x[1];
+    r[2] = coefficient*x[2];
+    r[3] = coefficient*x[3];
+
+    //0.5*t = D*conj(P)
+    quaternion_times_conj(x+4, x, r+4);
+}
+
+/**
+ * The exponential r of the pure dual quaternion x = p + E*d, that is, q + E*d*q with q = cos(|p|) + sinc(|p|)*p.
+ * The real part of x is ignored.
+ */
+template<typename Scalar>
+void exp(const Scalar* x, Scalar* r)
+{
+    using std::sqrt;
+    using std::cos;
+    const Scalar phi = sqrt(x[1]*x[1] + x[2]*x[2] + x[3]*x[3]);
+    const Scalar s   = sinc(phi);
+
+    r[0] = cos(phi);
+    r[1] = s*x[1];
+    r[2] = s*x[2];
+    r[3] = s*x[3];
+
+    const Scalar d[4] = {Scalar(0), x[5], x[6], x[7]};
+    quaternion_times(d, r, r+4);
+}
+
+/**
+ * The power r = exp(a*log(x)) of the unit dual quaternion x, in closed form.
+ */
+template<typename Scalar>
+void pow(const Scalar* x, const Scalar& a, Scalar* r)
+{
+    using std::sqrt;
+    using std::cos;
+    const Scalar im_norm = sqrt(x[1]*x[1] + x[2]*x[2] + x[3]*x[3]);
+
+    //The primary part of a*log() is a*coefficient*Im(P), whose norm is a*phi
+    const Scalar a_coefficient = a*angle_over_sin(x[0], im_norm);
+    const Scalar a_phi = a_coefficient*im_norm;
+    const Scalar s     = a_coefficient*sinc(a_phi);
+
+    r[0] = cos(a_phi);
+    r[1] = s*x[1];
+    r[2] = s*x[2];
+    r[3] = s*x[3];
+
+    //The dual part of a*log() is a*D*conj(P), and its real part is zero
+    Scalar a_half_translation[4];
+    quaternion_times_conj(x+4, x, a_half_translation);
+    a_half_translation[0] = Scalar(0);
+    for(int n = 1; n < 4; n++)
+        a_half_translation[n] *= a;
+    quaternion_times(a_half_translation, r, r+4);
+}
+
+}
+
+}
+
+#endif
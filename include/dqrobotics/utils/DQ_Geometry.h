@@ -38,6 +38,15 @@ public:
     static double point_to_plane_distance(const DQ& point, const DQ& plane);
 
     static double line_to_line_squared_distance(const DQ& line1, const DQ& line2);
+
+    //Same as above, without validating the inputs
+    static double point_to_point_squared_distance_unchecked(const DQ& point1, const DQ& point2);
+
+    static double point_to_line_squared_distance_unchecked(const DQ& point, const DQ& line);
+
+    static double point_to_plane_distance_unchecked(const DQ& point, const DQ& plane);
+
+    static double line_to_line_squared_distance_unchecked(const DQ& line1, const DQ& line2);
 };
 
 }
@@ -0,0 +1,145 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_UTILS_DQ_INSTRUMENTATION_H
+#define DQ_UTILS_DQ_INSTRUMENTATION_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Allocation and operation counting.
+ *
+ * Building the library with DQROBOTICS_INSTRUMENTATION, see the CMake option of the same name, makes it count, per
+ * thread, the heap allocations (malloc, calloc, realloc, memalign, aligned_alloc and posix_memalign calls made
+ * anywhere in the process, glibc only), the DQs built by the DQ constructors, and the DQ*DQ products. The calls of
+ * fkm(), pose_jacobian(), and of the static Jacobians of DQ_Kinematics are additionally recorded together with what
+ * they counted, see instrumentation_records().
+ *
+ * Without DQROBOTICS_INSTRUMENTATION this API is still available, all counters stay at zero, and the library code is
+ * exactly the same as without this header.
+ */
+#ifdef DQROBOTICS_INSTRUMENTATION
+#define DQROBOTICS_INSTRUMENT_CALL(name) const DQ_robotics::DQ_InstrumentedCall dqrobotics_instrumented_call_(name)
+#define DQROBOTICS_COUNT_DQ_CONSTRUCTION() DQ_robotics::instrumentation_count_dq_construction()
+#define DQROBOTICS_COUNT_DQ_PRODUCT() DQ_robotics::instrumentation_count_dq_product()
+#else
+#define DQROBOTICS_INSTRUMENT_CALL(name) ((void)0)
+#define DQROBOTICS_COUNT_DQ_CONSTRUCTION() ((void)0)
+#define DQROBOTICS_COUNT_DQ_PRODUCT() ((void)0)
+#endif
+
+namespace DQ_robotics
+{
+
+struct DQ_InstrumentationCounters
+{
+    std::size_t allocations;
+    std::size_t dq_constructions;
+    std::size_t dq_products;
+
+    DQ_InstrumentationCounters();
+};
+
+DQ_InstrumentationCounters operator+(const DQ_InstrumentationCounters& a, const DQ_InstrumentationCounters& b);
+DQ_InstrumentationCounters operator-(const DQ_InstrumentationCounters& a, const DQ_InstrumentationCounters& b);
+
+/**
+ * @brief What the calls of one instrumented function counted, inclusive of the functions it called.
+ */
+struct DQ_InstrumentationRecord
+{
+    std::string function_name;
+    std::size_t calls;
+    DQ_InstrumentationCounters totals;
+};
+
+bool instrumentation_enabled();
+
+DQ_InstrumentationCounters instrumentation_counters();
+
+std::vector<DQ_InstrumentationRecord> instrumentation_records();
+
+void reset_instrumentation_records();
+
+void instrumentation_count_dq_construction();
+
+void instrumentation_count_dq_product();
+
+/**
+ * @brief Counts what happens on the current thread between its construction and the call to counters().
+ */
+class DQ_InstrumentationScope
+{
+private:
+    const DQ_InstrumentationCounters start_;
+public:
+    DQ_InstrumentationScope();
+
+    DQ_InstrumentationCounters counters() const;
+};
+
+/**
+ * @brief Asserts that no heap allocation happens on the current thread while it is alive.
+ *
+ * The destructor throws a std::range_error naming @p description if an allocation was counted, unless the scope is
+ * being left because of another exception. Only meaningful when instrumentation_enabled(), otherwise it never throws.
+ */
+class DQ_NoAllocationScope
+{
+private:
+    const std::size_t start_allocations_;
+    const char* description_;
+public:
+    explicit DQ_NoAllocationScope(const char* description = "DQ_NoAllocationScope");
+    ~DQ_NoAllocationScope() noexcept(false);
+
+    std::size_t allocations() const;
+
+    DQ_NoAllocationScope(const DQ_NoAllocationScope&) = delete;
+    DQ_NoAllocationScope& operator=(const DQ_NoAllocationScope&) = delete;
+};
+
+/**
+ * @brief Used through DQROBOTICS_INSTRUMENT_CALL() to record one call of the enclosing function.
+ * @p function_name must outlive the thread, e.g. a string literal. A call made while another call with the same
+ * name is active, e.g. an overload delegating to another, is not recorded again.
+ */
+class DQ_InstrumentedCall
+{
+private:
+    const char* function_name_;
+    const DQ_InstrumentedCall* parent_;
+    bool nested_;
+    const DQ_InstrumentationCounters start_;
+public:
+    explicit DQ_InstrumentedCall(const char* function_name);
+    ~DQ_InstrumentedCall();
+
+    DQ_InstrumentedCall(const DQ_InstrumentedCall&) = delete;
+    DQ_InstrumentedCall& operator=(const DQ_InstrumentedCall&) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,266 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_UTILS_DQ_JET_H
+#define DQ_UTILS_DQ_JET_H
+
+#include<eigen3/Eigen/Dense>
+#include<cmath>
+#include<stdexcept>
+using namespace Eigen;
+
+namespace DQ_robotics
+{
+
+/**
+ * A truncated dual number a + v*epsilon, where epsilon^2 = 0 and v has one component per independent variable, for
+ * forward-mode automatic differentiation.
+ *
+ * Evaluating a function with DQ_Jet arguments gives its value in a and its partial derivatives in v. With N
+ * independent variables, e.g. the joints of a robot, the whole Jacobian comes out of a single evaluation. Every
+ * operation carries the N derivatives along as one small vector, so the cost is a few times that of the plain
+ * evaluation instead of the 2N evaluations of central finite differences, and the derivatives are exact.
+ *
+ * DQ_Jet is a scalar for GenericDQ and DQ_GenericSerialManipulator, see jet_variables() and jet_jacobian().
+ *
+ * Comparisons look at the value only, so branches follow those of the plain evaluation. The derivative of sqrt() at
+ * zero is taken as zero, which is what the small-angle branches of log(), exp(), and pow() need at the identity.
+ *
+ * Example:
+ *     typedef DQ_Jet<double,7> Jet;
+ *     DQ_GenericSerialManipulator<Jet> robot(KukaLw4Robot::kinematics());
+ *     GenericDQ<Jet> x = robot.fkm(jet_variables<7>(q));
+ *     Matrix<double,8,7> J = jet_jacobian(x.q);
+ */
+template<typename T, int N>
+struct DQ_Jet
+{
+    typedef Matrix<T,N,1,DontAlign> Derivatives;
+
+    T           a;
+    Derivatives v;
+
+    DQ_Jet(): a(T(0)), v(Derivatives::Zero()) {}
+    DQ_Jet(const T& value): a(value), v(Derivatives::Zero()) {}
+    DQ_Jet(const T& value, const int& k): a(value), v(Derivatives::Unit(k)) {}
+    DQ_Jet(const T& value, const Derivatives& derivatives): a(value), v(derivatives) {}
+
+    DQ_Jet& operator+=(const DQ_Jet& y) { a += y.a; v += y.v; return *this; }
+    DQ_Jet& operator-=(const DQ_Jet& y) { a -= y.a; v -= y.v; return *this; }
+    DQ_Jet& operator*=(const DQ_Jet& y) { v = y.a*v + a*y.v; a *= y.a; return *this; }
+    DQ_Jet& operator/=(const DQ_Jet& y) { const T inv = T(1)/y.a; a *= inv; v = (v - a*y.v)*inv; return *this; }
+    DQ_Jet& operator+=(const T& s) { a += s; return *this; }
+    DQ_Jet& operator-=(const T& s) { a -= s; return *this; }
+    DQ_Jet& operator*=(const T& s) { a *= s; v *= s; return *this; }
+    DQ_Jet& operator/=(const T& s) { const T inv = T(1)/s; a *= inv; v *= inv; return *this; }
+};
+
+/* **********************************************************************
+ *  ARITHMETIC
+ * *********************************************************************/
+
+template<typename T, int N> DQ_Jet<T,N> operator-(const DQ_Jet<T,N>& x) { return DQ_Jet<T,N>(-x.a, -x.v); }
+template<typename T, int N> DQ_Jet<T,N> operator+(const DQ_Jet<T,N>& x) { return x; }
+
+template<typename T, int N> DQ_Jet<T,N> operator+(const DQ_Jet<T,N>& x, const DQ_Jet<T,N>& y) { return DQ_Jet<T,N>(x.a + y.a, x.v + y.v); }
+template<typename T, int N> DQ_Jet<T,N> operator+(const DQ_Jet<T,N>& x, const T& s)            { return DQ_Jet<T,N>(x.a + s, x.v); }
+template<typename T, int N> DQ_Jet<T,N> operator+(const T& s, const DQ_Jet<T,N>& x)            { return DQ_Jet<T,N>(s + x.a, x.v); }
+
+template<typename T, int N> DQ_Jet<T,N> operator-(const DQ_Jet<T,N>& x, const DQ_Jet<T,N>& y) { return DQ_Jet<T,N>(x.a - y.a, x.v - y.v); }
+template<typename T, int N> DQ_Jet<T,N> operator-(const DQ_Jet<T,N>& x, const T& s)            { return DQ_Jet<T,N>(x.a - s, x.v); }
+template<typename T, int N> DQ_Jet<T,N> operator-(const T& s, const DQ_Jet<T,N>& x)            { return DQ_Jet<T,N>(s - x.a, -x.v); }
+
+template<typename T, int N> DQ_Jet<T,N> operator*(const DQ_Jet<T,N>& x, const DQ_Jet<T,N>& y) { return DQ_Jet<T,N>(x.a*y.a, y.a*x.v + x.a*y.v); }
+template<typename T, int N> DQ_Jet<T,N> operator*(const DQ_Jet<T,N>& x, const T& s)            { return DQ_Jet<T,N>(x.a*s, s*x.v); }
+template<typename T, int N> DQ_Jet<T,N> operator*(const T& s, const DQ_Jet<T,N>& x)            { return DQ_Jet<T,N>(s*x.a, s*x.v); }
+
+template<typename T, int N> DQ_Jet<T,N> operator/(const DQ_Jet<T,N>& x, const DQ_Jet<T,N>& y)
+{
+    const T inv = T(1)/y.a;
+    const T a = x.a*inv;
+    return DQ_Jet<T,N>(a, (x.v - a*y.v)*inv);
+}
+template<typename T, int N> DQ_Jet<T,N> operator/(const DQ_Jet<T,N>& x, const T& s) { const T inv = T(1)/s; return DQ_Jet<T,N>(x.a*inv, inv*x.v); }
+template<typename T, int N> DQ_Jet<T,N> operator/(const T& s, const DQ_Jet<T,N>& x)
+{
+    const T inv = T(1)/x.a;
+    return DQ_Jet<T,N>(s*inv, (-s*inv*inv)*x.v);
+}
+
+/* **********************************************************************
+ *  COMPARISONS (VALUE ONLY)
+ * *********************************************************************/
+
+#define DQ_JET_COMPARISON(op) \
+    template<typename T, int N> bool operator op(const DQ_Jet<T,N>& x, const DQ_Jet<T,N>& y) { return x.a op y.a; } \
+    template<typename T, int N> bool operator op(const DQ_Jet<T,N>& x, const T& s)            { return x.a op s; } \
+    template<typename T, int N> bool operator op(const T& s, const DQ_Jet<T,N>& x)            { return s op x.a; }
+DQ_JET_COMPARISON(<)
+DQ_JET_COMPARISON(<=)
+DQ_JET_COMPARISON(>)
+DQ_JET_COMPARISON(>=)
+DQ_JET_COMPARISON(==)
+DQ_JET_COMPARISON(!=)
+#undef DQ_JET_COMPARISON
+
+/* **********************************************************************
+ *  MATH FUNCTIONS (FOUND BY ARGUMENT-DEPENDENT LOOKUP)
+ * *********************************************************************/
+
+template<typename T, int N> DQ_Jet<T,N> abs(const DQ_Jet<T,N>& x)  { return x.a < T(0) ? -x : x; }
+template<typename T, int N> DQ_Jet<T,N> fabs(const DQ_Jet<T,N>& x) { return abs(x); }
+
+template<typename T, int N> DQ_Jet<T,N> sin(const DQ_Jet<T,N>& x)
+{
+    using std::sin;
+    using std::cos;
+    return DQ_Jet<T,N>(sin(x.a), cos(x.a)*x.v);
+}
+
+template<typename T, int N> DQ_Jet<T,N> cos(const DQ_Jet<T,N>& x)
+{
+    using std::sin;
+    using std::cos;
+    return DQ_Jet<T,N>(cos(x.a), -sin(x.a)*x.v);
+}
+
+template<typename T, int N> DQ_Jet<T,N> sqrt(const DQ_Jet<T,N>& x)
+{
+    using std::sqrt;
+    const T s = sqrt(x.a);
+    if(s == T(0))
+        return DQ_Jet<T,N>(s);
+    return DQ_Jet<T,N>(s, (T(0.5)/s)*x.v);
+}
+
+template<typename T, int N> DQ_Jet<T,N> exp(const DQ_Jet<T,N>& x)
+{
+    using std::exp;
+    const T e = exp(x.a);
+    return DQ_Jet<T,N>(e, e*x.v);
+}
+
+template<typename T, int N> DQ_Jet<T,N> log(const DQ_Jet<T,N>& x)
+{
+    using std::log;
+    return DQ_Jet<T,N>(log(x.a), (T(1)/x.a)*x.v);
+}
+
+template<typename T, int N> DQ_Jet<T,N> acos(const DQ_Jet<T,N>& x)
+{
+    using std::acos;
+    using std::sqrt;
+    return DQ_Jet<T,N>(acos(x.a), (-T(1)/sqrt(T(1) - x.a*x.a))*x.v);
+}
+
+/**
+ * atan2(y,x), whose derivative is (x*dy - y*dx)/(x^2 + y^2).
+ */
+template<typename T, int N> DQ_Jet<T,N> atan2(const DQ_Jet<T,N>& y, const DQ_Jet<T,N>& x)
+{
+    using std::atan2;
+    const T inv_squared_norm = T(1)/(x.a*x.a + y.a*y.a);
+    return DQ_Jet<T,N>(atan2(y.a, x.a), inv_squared_norm*(x.a*y.v - y.a*x.v));
+}
+
+/* **********************************************************************
+ *  SEEDING AND EXTRACTION
+ * *********************************************************************/
+
+/**
+ * @brief jet_variables the independent variables x, with value x(k) and derivative 1 in the k-th component.
+ * @exception std::range_error if @p x does not have N elements.
+ */
+template<int N>
+Matrix<DQ_Jet<double,N>,N,1> jet_variables(const VectorXd& x)
+{
+    if(int(x.size()) != N)
+    {
+        throw std::range_error("Bad jet_variables(x) call: x must have as many elements as the jet has derivatives");
+    }
+    Matrix<DQ_Jet<double,N>,N,1> variables;
+    for(int k = 0; k < N; k++)
+        variables(k) = DQ_Jet<double,N>(x(k), k);
+    return variables;
+}
+
+/**
+ * @brief jet_values the value of each element of @p f.
+ */
+template<typename T, int N, int M>
+Matrix<T,M,1> jet_values(const Matrix<DQ_Jet<T,N>,M,1>& f)
+{
+    Matrix<T,M,1> values(f.size());
+    for(int i = 0; i < int(f.size()); i++)
+        values(i) = f(i).a;
+    return values;
+}
+
+/**
+ * @brief jet_jacobian the Jacobian of @p f w.r.t. the independent variables, one row per element of @p f.
+ */
+template<typename T, int N, int M>
+Matrix<T,M,N> jet_jacobian(const Matrix<DQ_Jet<T,N>,M,1>& f)
+{
+    Matrix<T,M,N> jacobian(f.size(), N);
+    for(int i = 0; i < int(f.size()); i++)
+        jacobian.row(i) = f(i).v.transpose();
+    return jacobian;
+}
+
+}
+
+namespace Eigen
+{
+
+/**
+ * Lets Eigen matrices hold DQ_Jet coefficients.
+ */
+template<typename T, int N>
+struct NumTraits<DQ_robotics::DQ_Jet<T,N>>: GenericNumTraits<DQ_robotics::DQ_Jet<T,N>>
+{
+    typedef DQ_robotics::DQ_Jet<T,N> Real;
+    typedef DQ_robotics::DQ_Jet<T,N> NonInteger;
+    typedef DQ_robotics::DQ_Jet<T,N> Nested;
+    typedef DQ_robotics::DQ_Jet<T,N> Literal;
+
+    enum
+    {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = (N+1)*NumTraits<T>::ReadCost,
+        AddCost  = (N+1)*NumTraits<T>::AddCost,
+        MulCost  = (2*N+1)*NumTraits<T>::MulCost + N*NumTraits<T>::AddCost
+    };
+
+    static inline Real epsilon()         { return Real(NumTraits<T>::epsilon()); }
+    static inline Real dummy_precision() { return Real(NumTraits<T>::dummy_precision()); }
+    static inline Real highest()         { return Real(NumTraits<T>::highest()); }
+    static inline Real lowest()          { return Real(NumTraits<T>::lowest()); }
+    static inline int  digits10()        { return NumTraits<T>::digits10(); }
+};
+
+}
+
+#endif
@@ -30,6 +30,37 @@ namespace DQ_robotics
 {
 
 MatrixXd pinv(const MatrixXd& matrix);
+MatrixXd truncated_pinv(const MatrixXd& matrix, const double& tolerance);
+MatrixXd damped_pinv(const MatrixXd& matrix, const double& damping);
+
+/**
+ * Scratch memory of the pseudo-inverse overloads that write into a preallocated result. It is sized by the first
+ * call, or by the constructor, and reused as long as the size of the input does not change, so that those overloads
+ * do not allocate. The eigendecomposition used by truncated_pinv() has a fixed capacity of 8x8, enough for the Gram
+ * matrix of any pose Jacobian, and lives inside the workspace.
+ */
+struct DQ_PseudoinverseWorkspace
+{
+    typedef Matrix<double,Dynamic,Dynamic,0,8,8> GramMatrix;
+
+    JacobiSVD<MatrixXd>                 svd;
+    LDLT<MatrixXd>                      ldlt;
+    MatrixXd                            gram;
+    MatrixXd                            scaled_v;
+    SelfAdjointEigenSolver<GramMatrix>  eigen_solver;
+    GramMatrix                          small_gram;
+    GramMatrix                          scaled_eigenvectors;
+
+    //Fixed-capacity Eigen members, so heap-allocated workspaces must be aligned
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    DQ_PseudoinverseWorkspace() = default;
+    DQ_PseudoinverseWorkspace(const int& rows, const int& cols);
+};
+
+void pinv(const MatrixXd& matrix, DQ_PseudoinverseWorkspace& workspace, Ref<MatrixXd> pseudo_inverse);
+void truncated_pinv(const MatrixXd& matrix, const double& tolerance, DQ_PseudoinverseWorkspace& workspace, Ref<MatrixXd> pseudo_inverse);
+void damped_pinv(const MatrixXd& matrix, const double& damping, DQ_PseudoinverseWorkspace& workspace, Ref<MatrixXd> pseudo_inverse);
 
 }
 
@@ -0,0 +1,39 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_UTILS_DQ_PARALLEL_H
+#define DQ_UTILS_DQ_PARALLEL_H
+
+#include<functional>
+
+namespace DQ_robotics
+{
+
+int parallel_number_of_workers(const int& number_of_tasks, const int& number_of_threads);
+
+void parallel_for(const int& number_of_tasks,
+                  const int& number_of_threads,
+                  const std::function<void(const int& task, const int& worker)>& task_function);
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_UTILS_DQ_VALIDATION_H
+#define DQ_UTILS_DQ_VALIDATION_H
+
+/**
+ * Input validation policy.
+ *
+ * Operations that are only defined for some dual quaternions (unit, pure, lines, planes) check their inputs and throw
+ * a std::range_error otherwise. Building the library with DQROBOTICS_DISABLE_INPUT_VALIDATION, see the CMake option
+ * of the same name, removes these checks from release builds. Builds without NDEBUG always validate. Checks on the
+ * sizes of vectors and matrices are not affected by this policy.
+ *
+ * Independently of the policy, hot loops can call the *_unchecked variants, e.g. log_unchecked() or tplus_unchecked().
+ */
+#if defined(DQROBOTICS_DISABLE_INPUT_VALIDATION) && defined(NDEBUG)
+#define DQROBOTICS_INPUT_VALIDATION 0
+#else
+#define DQROBOTICS_INPUT_VALIDATION 1
+#endif
+
+namespace DQ_robotics
+{
+
+bool input_validation_enabled();
+
+}
+
+#endif
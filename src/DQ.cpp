@@ -22,6 +22,9 @@ Contributors:
 */
 
 #include<dqrobotics/DQ.h>
+#include<dqrobotics/utils/DQ_CoefficientKernels.h>
+#include<dqrobotics/utils/DQ_Instrumentation.h>
+#include<dqrobotics/utils/DQ_Validation.h>
 #include <sstream>
 #include <math.h>
 #include <stdexcept> //for range_error
@@ -36,6 +39,34 @@ const DQ DQ::j(0,0,1,0,0,0,0,0);
 const DQ DQ::k(0,0,0,1,0,0,0,0);
 const DQ DQ::E(0,0,0,0,1,0,0,0);
 
+namespace
+{
+
+/**
+ * Same as dq.norm() == 1, but computed from the coefficients instead of through conj(dq)*dq.
+ * The primary part of the norm is |P(dq)| and its dual part is dot(P(dq),D(dq))/|P(dq)|.
+ */
+bool is_unit_(const DQ& dq)
+{
+    const double* q = dq.q.data();
+    const double primary = sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+    if(primary == 0.0)
+        return false;
+    const double dual = (q[0]*q[4] + q[1]*q[5] + q[2]*q[6] + q[3]*q[7])/primary;
+    return fabs(primary - 1.0) <= DQ_threshold && fabs(dual) <= DQ_threshold;
+}
+
+void threshold_(DQ& dq)
+{
+    for(int n = 0; n < 8; n++)
+    {
+        if(fabs(dq.q(n)) < DQ_threshold )
+            dq.q(n) = 0;
+    }
+}
+
+}
+
 /****************************************************************
 **************NAMESPACE ONLY FUNCTIONS***************************
 *****************************************************************/
@@ -188,6 +219,30 @@ DQ pow(const DQ& dq, const double& a)
     return dq.pow(a);
 }
 
+/**
+ * @brief log_unchecked same as log(), without checking that @p dq is a unit DQ.
+ */
+DQ log_unchecked(const DQ& dq)
+{
+    return dq.log_unchecked();
+}
+
+/**
+ * @brief exp_unchecked same as exp(), without checking that @p dq is pure.
+ */
+DQ exp_unchecked(const DQ& dq)
+{
+    return dq.exp_unchecked();
+}
+
+/**
+ * @brief pow_unchecked same as pow(), without checking that @p dq is a unit DQ.
+ */
+DQ pow_unchecked(const DQ& dq, const double& a)
+{
+    return dq.pow_unchecked(a);
+}
+
 /**
 * Exponential operator -> retrieves the Exponential of a DQ.
 *
@@ -199,6 +254,14 @@ DQ tplus(const DQ& dq)
     return dq.tplus();
 }
 
+/**
+ * @brief tplus_unchecked same as tplus(), without checking that @p dq is a unit DQ.
+ */
+DQ tplus_unchecked(const DQ& dq)
+{
+    return dq.tplus_unchecked();
+}
+
 /**
 * Inverse of a unit DQ under decompositional multiplication.
 *
@@ -268,6 +331,76 @@ Matrix<double,8,8> haminus8(const DQ& dq)
     return dq.haminus8();
 }
 
+namespace
+{
+/**
+* Product of a matrix with the structure of hamiplus8() or haminus8(), [primary 0; dual primary], and the columns of
+* matrix. Only the three non-zero 4x4 blocks are multiplied, with fixed-size products that Eigen vectorizes for the
+* instruction set the library is compiled for (SSE2, AVX/FMA with -march flags, NEON), or evaluates with scalar code
+* when vectorization is disabled. Each column is read completely before it is written, so result may alias matrix.
+*/
+void hamilton8_product_(const Matrix4d& primary, const Matrix4d& dual, const Ref<const MatrixXd>& matrix, Ref<MatrixXd> result, const char* function_name)
+{
+    if(matrix.rows() != 8 || result.rows() != 8 || result.cols() != matrix.cols())
+    {
+        throw std::range_error(std::string("Bad ") + function_name + "(dq,matrix,result) call: matrix and result must be 8xn");
+    }
+    for(int j = 0; j < matrix.cols(); j++)
+    {
+        const Vector4d p = matrix.col(j).head<4>();
+        const Vector4d d = matrix.col(j).tail<4>();
+        result.col(j).head<4>().noalias() = primary*p;
+        result.col(j).tail<4>().noalias() = dual*p + primary*d;
+    }
+}
+}
+
+/**
+* The same as hamiplus8(dq)*matrix, that is, the column j of the result is vec8(dq*DQ(matrix.col(j))), without building
+* the dense 8x8 matrix and skipping its zero block.
+*
+* @param dq The DQ multiplying the columns of matrix on the left.
+* @param matrix An 8xn matrix, usually a Jacobian.
+* @param result An 8xn matrix that receives the product, may be matrix itself. Nothing is allocated.
+*/
+void hamiplus8_product(const DQ& dq, const Ref<const MatrixXd>& matrix, Ref<MatrixXd> result)
+{
+    hamilton8_product_(dq.P().hamiplus4(), dq.D().hamiplus4(), matrix, result, "hamiplus8_product");
+}
+
+/**
+* The same as hamiplus8(dq)*matrix, see hamiplus8_product(dq,matrix,result).
+*/
+MatrixXd hamiplus8_product(const DQ& dq, const Ref<const MatrixXd>& matrix)
+{
+    MatrixXd result(8, matrix.cols());
+    hamiplus8_product(dq, matrix, result);
+    return result;
+}
+
+/**
+* The same as haminus8(dq)*matrix, that is, the column j of the result is vec8(DQ(matrix.col(j))*dq), without building
+* the dense 8x8 matrix and skipping its zero block.
+*
+* @param dq The DQ multiplying the columns of matrix on the right.
+* @param matrix An 8xn matrix, usually a Jacobian.
+* @param result An 8xn matrix that receives the product, may be matrix itself. Nothing is allocated.
+*/
+void haminus8_product(const DQ& dq, const Ref<const MatrixXd>& matrix, Ref<MatrixXd> result)
+{
+    hamilton8_product_(dq.P().haminus4(), dq.D().haminus4(), matrix, result, "haminus8_product");
+}
+
+/**
+* The same as haminus8(dq)*matrix, see haminus8_product(dq,matrix,result).
+*/
+MatrixXd haminus8_product(const DQ& dq, const Ref<const MatrixXd>& matrix)
+{
+    MatrixXd result(8, matrix.cols());
+    haminus8_product(dq, matrix, result);
+    return result;
+}
+
 /**
 * Vect operator on the primary part of a DQ.
 *
@@ -336,10 +469,18 @@ DQ sharp(const DQ& dq)
  */
 DQ dot(const DQ& dq1, const DQ& dq2)
 {
-    if(dq1!=Im(dq1) || dq2!=Im(dq2))
+    if(DQROBOTICS_INPUT_VALIDATION && (!is_pure(dq1) || !is_pure(dq2)))
     {
         throw std::range_error("One of the inputs is not imaginary in dot");
     }
+    return dot_unchecked(dq1, dq2);
+}
+
+/**
+ * @brief dot_unchecked same as dot(), without checking that the inputs are pure.
+ */
+DQ dot_unchecked(const DQ& dq1, const DQ& dq2)
+{
     return -1.0*(dq1*dq2+dq2*dq1)*0.5;
 }
 
@@ -352,10 +493,18 @@ DQ dot(const DQ& dq1, const DQ& dq2)
  */
 DQ cross(const DQ& dq1, const DQ& dq2)
 {
-    if(dq1!=Im(dq1) || dq2!=Im(dq2))
+    if(DQROBOTICS_INPUT_VALIDATION && (!is_pure(dq1) || !is_pure(dq2)))
     {
         throw std::range_error("One of the inputs is not imaginary in cross");
     }
+    return cross_unchecked(dq1, dq2);
+}
+
+/**
+ * @brief cross_unchecked same as cross(), without checking that the inputs are pure.
+ */
+DQ cross_unchecked(const DQ& dq1, const DQ& dq2)
+{
     return (dq1*dq2-dq2*dq1)*0.5;
 }
 
@@ -384,13 +533,14 @@ double DQ::q_(const int a) const
 }
 
 /**
-* DQ constructor using boost vector
+* DQ constructor using an Eigen vector
 *
 * Returns a DQ object with the values of elements equal to the values of elements from a vector 'v' passed to constructor.
+* Fixed-size vectors (e.g. Vector4d or Matrix<double,8,1>) are read in place, without a temporary VectorXd.
 * \param vector <double> v contain the values to copied to the attribute q.
 */
-DQ::DQ(const VectorXd& v) {
-    q.resize(8);
+DQ::DQ(const Ref<const VectorXd>& v) {
+    DQROBOTICS_COUNT_DQ_CONSTRUCTION();
     if(v.size()>8)
     {
         throw std::range_error("Trying to initialize a DQ with a vector of size >8 is not allowed.");
@@ -414,8 +564,8 @@ DQ::DQ(const VectorXd& v) {
 * \param double q0,q1,q2,q3,q4,q5,q6 and q7 are the values to be copied to the member 'q'.
 */
 DQ::DQ(const double& q0,const double& q1,const double& q2,const double& q3,const double& q4,const double& q5,const double& q6,const double& q7) {
+    DQROBOTICS_COUNT_DQ_CONSTRUCTION();
 
-    q.resize(8);
     q(0) = q0;
     q(1) = q1;
     q(2) = q2;
@@ -569,7 +719,7 @@ DQ DQ::inv() const{
 DQ DQ::translation() const
 {
     //Verify if unit quaternion
-    if (this->norm() != 1)
+    if (DQROBOTICS_INPUT_VALIDATION && !is_unit_(*this))
     {
         throw(std::range_error("Bad translation() call: Not a unit dual quaternion"));
     }
@@ -596,7 +746,7 @@ DQ DQ::translation() const
 DQ DQ::rotation() const
 {
     //Verify if unit quaternion
-    if (this->norm() != 1)
+    if (DQROBOTICS_INPUT_VALIDATION && !is_unit_(*this))
     {
         throw(std::range_error("Bad rotation() call: Not a unit dual quaternion"));
     }
@@ -616,7 +766,7 @@ DQ DQ::rotation() const
 DQ DQ::rotation_axis() const{
 
     // Verify if the object caller is a unit DQ
-    if (this->norm() != 1) {
+    if (DQROBOTICS_INPUT_VALIDATION && !is_unit_(*this)) {
         throw(std::range_error("Bad rot_axis() call: Not a unit dual quaternion"));
     }
 
@@ -652,7 +802,7 @@ DQ DQ::rotation_axis() const{
 double DQ::rotation_angle() const{
 
     // Verify if the object caller is a unit DQ
-    if (this->norm() != 1) {
+    if (DQROBOTICS_INPUT_VALIDATION && !is_unit_(*this)) {
         throw(std::range_error("Bad rot_angle() call: Not a unit dual quaternion"));
     }
 
@@ -665,80 +815,99 @@ double DQ::rotation_angle() const{
 /**
 * Returns a constant DQ object representing the logaritm of the unit DQ object caller.
 *
-* Creates a dual quaternion with calculated values for the logaritm and return a DQ object.
+* For a unit DQ r + E*0.5*t*r, with r = cos(phi) + n*sin(phi), the logarithm is phi*n + E*0.5*t. It is evaluated in
+* closed form from the coefficients, with a series expansion for small angles.
 * To use this member function, type: 'dq_object.log();'.
 * \return A constant DQ object.
-* \sa DQ(), DQ(double q0,double q1,double q2,double q3,double q4,double q5,double q6,double q7).
+* \sa log_unchecked().
 */
 DQ DQ::log() const{
 
     // Verify if the object caller is a unit DQ
-    if (this->norm() != 1) {
+    if (DQROBOTICS_INPUT_VALIDATION && !is_unit_(*this)) {
         throw(std::range_error("Bad log() call: Not a unit dual quaternion"));
     }
 
-    // log calculation
-    DQ p = acos(this->q(0)) * this->rotation_axis(); //primary
-    DQ d = 0.5 * this->translation(); //dual
-    DQ log(p.q(0),p.q(1),p.q(2),p.q(3),d.q(0),d.q(1),d.q(2),d.q(3));
+    return log_unchecked();
+}
+
+/**
+* Same as log(), without checking that the object caller is a unit DQ. If it is not, the result is meaningless.
+*/
+DQ DQ::log_unchecked() const{
+
+    DQ log;
+    dq_kernels::log(q.data(), log.q.data());
 
     // using threshold to verify zero values in DQ to be returned
-    for(int n = 0; n < 8; n++)
-    {
-        if(fabs(log.q(n)) < DQ_threshold )
-            log.q(n) = 0;
-    }
+    threshold_(log);
 
     return log;
-
 }
 
 /**
-* Returns a constant DQ object representing the exponential of the unit DQ object caller.
+* Returns a constant DQ object representing the exponential of the pure DQ object caller.
 *
-* Creates a dual quaternion with calculated values for the exponential and return a DQ object.
+* For a pure DQ p + E*d, the exponential is r + E*d*r, where r = cos(|p|) + sin(|p|)/|p|*p. It is evaluated in closed
+* form from the coefficients, with a series expansion for small angles.
 * To use this member function, type: 'dq_object.exp();'.
 * \return A constant DQ object.
-* \sa DQ().
+* \sa exp_unchecked().
 */
 DQ DQ::exp() const{
 
-    double phi;
-    DQ prim;
-    DQ exp;
-
-    if( this->Re() != 0.0 )
+    if( DQROBOTICS_INPUT_VALIDATION && !is_pure(*this) )
     {
         throw(std::range_error("Bad exp() call: Exponential operation is defined only for pure dual quaterions."));
     }
 
-    prim = this->P();
-    phi  = prim.q.norm();
+    return exp_unchecked();
+}
 
-    if(phi != 0.0)
-        prim = cos(phi) + (sin(phi)/phi)*this->P();
-    else
-        prim = DQ(1.0);
+/**
+* Same as exp(), without checking that the object caller is pure. Its real part is ignored.
+*/
+DQ DQ::exp_unchecked() const{
 
-    exp = ( prim + E_*this->D()*prim );
+    DQ exp;
+    dq_kernels::exp(q.data(), exp.q.data());
 
     // using threshold to verify zero values in DQ to be returned
-    for(int n = 0; n < 8; n++) {
-        if(fabs(exp.q(n)) < DQ_threshold )
-            exp.q(n) = 0;
-    }
+    threshold_(exp);
 
     return exp;
-
 }
 
 /**
-
+* Returns a constant DQ object representing the unit DQ object caller to the power a, that is, exp(a*log()).
+*
+* It is evaluated in closed form from the coefficients, without computing the logarithm and the exponential separately.
+* \param a the exponent.
+* \return A constant DQ object.
+* \sa pow_unchecked().
 */
 DQ DQ::pow(const double a) const
 {
-    DQ logtimesa = a*this->log();
-    return logtimesa.exp();
+    // Verify if the object caller is a unit DQ
+    if (DQROBOTICS_INPUT_VALIDATION && !is_unit_(*this)) {
+        throw(std::range_error("Bad pow() call: Not a unit dual quaternion"));
+    }
+
+    return pow_unchecked(a);
+}
+
+/**
+* Same as pow(), without checking that the object caller is a unit DQ. If it is not, the result is meaningless.
+*/
+DQ DQ::pow_unchecked(const double a) const
+{
+    DQ pow;
+    dq_kernels::pow(q.data(), a, pow.q.data());
+
+    // using threshold to verify zero values in DQ to be returned
+    threshold_(pow);
+
+    return pow;
 }
 
 /**
@@ -751,26 +920,28 @@ DQ DQ::pow(const double a) const
 */
 DQ DQ::tplus() const{
 
-    DQ tplus;
-
     // Verify if the object caller is a unit DQ
-    if (this->norm() != 1) {
+    if (DQROBOTICS_INPUT_VALIDATION && !is_unit_(*this)) {
         throw(std::range_error("Bad tplus() call: Not a unit dual quaternion"));
     }
 
-    // tplus operator calculation
-    tplus = this->P();
-    tplus = (*this) * tplus.conj();
+    return tplus_unchecked();
+}
+
+/**
+* Same as tplus(), without checking that the object caller is a unit DQ.
+* It evaluates (*this)*conj(P()) = P()*conj(P()) + E*D()*conj(P()) directly from the coefficients.
+*/
+DQ DQ::tplus_unchecked() const{
+
+    DQ tplus;
+    dq_kernels::quaternion_times_conj(q.data(),   q.data(), tplus.q.data());
+    dq_kernels::quaternion_times_conj(q.data()+4, q.data(), tplus.q.data()+4);
 
     // using threshold to verify zero values in DQ to be returned
-    for(int n = 0; n < 8; n++)
-    {
-        if(fabs(tplus.q(n)) < DQ_threshold )
-            tplus.q(n) = 0;
-    }
+    threshold_(tplus);
 
     return tplus;
-
 }
 
 /**
@@ -788,7 +959,7 @@ DQ DQ::pinv() const{
     DQ tinv;
 
     // Verify if the object caller is a unit DQ
-    if (this->norm() != 1) {
+    if (DQROBOTICS_INPUT_VALIDATION && !is_unit_(*this)) {
         throw(std::range_error("Bad pinv() call: Not a unit dual quaternion"));
     }
 
@@ -1305,32 +1476,23 @@ DQ operator-(const double& scalar, const DQ& dq){
 *
 * This friend function do the standard multiplication of two DQ objects and returns the result on another DQ object which
 * is created with default constructor and have the vector 'q' modified acording to the operation.
+* The product is evaluated by a straight-line kernel on the primary and dual halves, so no DQ temporaries are created
+* and the threshold is applied only once, to the result.
 * \param dq1 is the first DQ object in the operation.
 * \param dq2 is the second DQ object in the operation.
 * \return A DQ object.
-* \sa DQ(), D(), P(), threshold().
+* \sa DQ(), threshold().
 */
 DQ operator*(const DQ& dq1, const DQ& dq2){
+    DQROBOTICS_COUNT_DQ_PRODUCT();
     DQ dq;
 
-    dq.q(0) = dq1.q(0)*dq2.q(0) - dq1.q(1)*dq2.q(1) - dq1.q(2)*dq2.q(2) - dq1.q(3)*dq2.q(3);
-    dq.q(1) = dq1.q(0)*dq2.q(1) + dq1.q(1)*dq2.q(0) + dq1.q(2)*dq2.q(3) - dq1.q(3)*dq2.q(2);
-    dq.q(2) = dq1.q(0)*dq2.q(2) - dq1.q(1)*dq2.q(3) + dq1.q(2)*dq2.q(0) + dq1.q(3)*dq2.q(1);
-    dq.q(3) = dq1.q(0)*dq2.q(3) + dq1.q(1)*dq2.q(2) - dq1.q(2)*dq2.q(1) + dq1.q(3)*dq2.q(0);
-
-    dq.q(4) = dq1.q(0)*dq2.D().q(0) - dq1.q(1)*dq2.D().q(1) - dq1.q(2)*dq2.D().q(2) - dq1.q(3)*dq2.D().q(3);
-    dq.q(5) = dq1.q(0)*dq2.D().q(1) + dq1.q(1)*dq2.D().q(0) + dq1.q(2)*dq2.D().q(3) - dq1.q(3)*dq2.D().q(2);
-    dq.q(6) = dq1.q(0)*dq2.D().q(2) - dq1.q(1)*dq2.D().q(3) + dq1.q(2)*dq2.D().q(0) + dq1.q(3)*dq2.D().q(1);
-    dq.q(7) = dq1.q(0)*dq2.D().q(3) + dq1.q(1)*dq2.D().q(2) - dq1.q(2)*dq2.D().q(1) + dq1.q(3)*dq2.D().q(0);
-
-    dq.q(4) = dq.q(4) + dq1.D().q(0)*dq2.P().q(0) - dq1.D().q(1)*dq2.P().q(1) - dq1.D().q(2)*dq2.P().q(2) - dq1.D().q(3)*dq2.P().q(3);
-    dq.q(5) = dq.q(5) + dq1.D().q(0)*dq2.P().q(1) + dq1.D().q(1)*dq2.P().q(0) + dq1.D().q(2)*dq2.P().q(3) - dq1.D().q(3)*dq2.P().q(2);
-    dq.q(6) = dq.q(6) + dq1.D().q(0)*dq2.P().q(2) - dq1.D().q(1)*dq2.P().q(3) + dq1.D().q(2)*dq2.P().q(0) + dq1.D().q(3)*dq2.P().q(1);
-    dq.q(7) = dq.q(7) + dq1.D().q(0)*dq2.P().q(3) + dq1.D().q(1)*dq2.P().q(2) - dq1.D().q(2)*dq2.P().q(1) + dq1.D().q(3)*dq2.P().q(0);
+    double* r = dq.q.data();
+    dq_kernels::product(dq1.q.data(), dq2.q.data(), r);
 
     for(int n = 0; n < 8; n++) {
-        if(fabs(dq.q(n)) < DQ_threshold )
-            dq.q(n) = 0;
+        if(fabs(r[n]) < DQ_threshold )
+            r[n] = 0;
     }
 
     return dq;
@@ -1431,15 +1593,16 @@ DQ operator*(const double& scalar, const DQ& dq) {
 /**
 * Operator (==) overload for the comparison between two DQ objects.
 *
-* This function do the comparison of two DQ objects. One is the DQ object caller, the first member in operation.
-* The result is returned as a boolean variable. True, means that both DQ objects are equal.
+* This function do the comparison of two DQ objects. It is not a member so that both operands convert implicitly,
+* e.g. UnitDQ == DQ. The result is returned as a boolean variable. True, means that both DQ objects are equal.
+* \param dq1 is the first DQ object in the operation.
 * \param dq2 is the second DQ object in the operation.
 * \return A boolean variable.
 * \sa threshold().
 */
-bool DQ::operator==(const DQ& dq2) const{
+bool operator==(const DQ& dq1, const DQ& dq2){
     for(int n = 0; n<8; n++) {
-        if(fabs(q(n) - dq2.q_(n)) > DQ_threshold )
+        if(fabs(dq1.q(n) - dq2.q(n)) > DQ_threshold )
             return false; //elements of Dual Quaternion different of scalar
     }
     return true; //elements of Dual Quaternion equal to scalar
@@ -1546,15 +1709,16 @@ bool operator==(const double& scalar, const DQ& dq) {
 /**
 * Operator (!=) overload for the comparison between two DQ objects.
 *
-* This function do the comparison of two DQ objects. One is the DQ object caller, the first member in operation.
-* The result is returned as a boolean variable. True, means that DQ objects are not equal.
+* This function do the comparison of two DQ objects. It is not a member so that both operands convert implicitly,
+* e.g. UnitDQ != DQ. The result is returned as a boolean variable. True, means that DQ objects are not equal.
+* \param dq1 is the first DQ object in the operation.
 * \param dq2 is the second DQ object in the operation.
 * \return A boolean variable.
 * \sa threshold().
 */
-bool DQ::operator!=(const DQ& dq2) const{
+bool operator!=(const DQ& dq1, const DQ& dq2){
     for(int n = 0; n<8; n++){
-        if(fabs(q(n) - dq2.q(n)) > DQ_threshold )
+        if(fabs(dq1.q(n) - dq2.q(n)) > DQ_threshold )
             return true; //elements of Dual Quaternion different of scalar
     }
     return false; //elements of Dual Quaternion equal to scalar
@@ -1722,10 +1886,7 @@ Matrix<double,4,4>  C4()
  */
 bool is_unit(const DQ& dq)
 {
-    if(norm(dq)==1.0)
-        return true;
-    else
-        return false;
+    return is_unit_(dq);
 }
 
 /**
@@ -1735,10 +1896,7 @@ bool is_unit(const DQ& dq)
  */
 bool is_pure(const DQ& dq)
 {
-    if(Re(dq)==0.0)
-        return true;
-    else
-        return false;
+    return fabs(dq.q(0)) <= DQ_threshold && fabs(dq.q(4)) <= DQ_threshold;
 }
 
 /**
@@ -1748,10 +1906,12 @@ bool is_pure(const DQ& dq)
  */
 bool is_real(const DQ& dq)
 {
-    if(Im(dq)==0.0)
-        return true;
-    else
-        return false;
+    for(int n = 1; n < 8; n++)
+    {
+        if(n != 4 && fabs(dq.q(n)) > DQ_threshold)
+            return false;
+    }
+    return true;
 }
 
 /**
@@ -1774,10 +1934,12 @@ bool is_real_number(const DQ& dq)
  */
 bool is_quaternion(const DQ& dq)
 {
-    if(D(dq)==0.0)
-        return true;
-    else
-        return false;
+    for(int n = 4; n < 8; n++)
+    {
+        if(fabs(dq.q(n)) > DQ_threshold)
+            return false;
+    }
+    return true;
 }
 
 /**
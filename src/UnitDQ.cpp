@@ -0,0 +1,239 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/UnitDQ.h>
+#include<dqrobotics/DQ_Expression.h>
+#include<cmath>
+#include<stdexcept>
+
+namespace DQ_robotics
+{
+
+/****************************************************************
+**************UNITDQ CLASS METHODS*******************************
+*****************************************************************/
+
+/**
+* The identity, 1.
+*/
+UnitDQ::UnitDQ():
+    DQ(1)
+{
+
+}
+
+/**
+* Normalizes @p dq. With dq = P + E*D, the result is P/|P| + E*(D/|P| - P*dot(P,D)/|P|^3), the same as normalize(dq)
+* evaluated from the coefficients.
+* \param DQ dq must have a nonzero primary part.
+*/
+UnitDQ::UnitDQ(const DQ& dq)
+{
+    const double* x = dq.q.data();
+    const double squared_norm = x[0]*x[0] + x[1]*x[1] + x[2]*x[2] + x[3]*x[3];
+    if(squared_norm == 0.0)
+    {
+        throw std::range_error("Bad UnitDQ(dq) call: the primary part of dq is zero");
+    }
+    const double inverse_norm = 1.0/std::sqrt(squared_norm);
+    const double projection = (x[0]*x[4] + x[1]*x[5] + x[2]*x[6] + x[3]*x[7])/squared_norm;
+
+    double* r = q.data();
+    for(int n = 0; n < 4; n++)
+    {
+        r[n]   = inverse_norm*x[n];
+        r[n+4] = inverse_norm*(x[n+4] - projection*x[n]);
+    }
+    for(int n = 0; n < 8; n++)
+    {
+        if(std::fabs(r[n]) < DQ_threshold)
+            r[n] = 0;
+    }
+}
+
+UnitDQ::UnitDQ(const DQ& dq, const Unchecked&):
+    DQ(dq)
+{
+
+}
+
+/**
+* Wraps @p dq without normalizing it. Use it only for values that are unit by construction, e.g. the result of a
+* forward kinematics computed from unit dual quaternions.
+*/
+UnitDQ UnitDQ::unchecked(const DQ& dq)
+{
+    return UnitDQ(dq, Unchecked());
+}
+
+UnitDQ UnitDQ::conj() const
+{
+    return UnitDQ(DQ::conj(), Unchecked());
+}
+
+/**
+* The inverse of a unit dual quaternion is its conjugate.
+*/
+UnitDQ UnitDQ::inv() const
+{
+    return conj();
+}
+
+UnitDQ UnitDQ::rotation() const
+{
+    return UnitDQ(DQ::P(), Unchecked());
+}
+
+/**
+* Same as DQ::translation(), without validation. With x = P + E*D, the translation is 2*D*conj(P), whose real part is
+* zero for a unit x.
+*/
+DQ UnitDQ::translation() const
+{
+    const DQ half_translation = DQ_robotics::D(tplus_unchecked());
+    return DQ(0, 2.0*half_translation.q(1), 2.0*half_translation.q(2), 2.0*half_translation.q(3));
+}
+
+DQ UnitDQ::rotation_axis() const
+{
+    const double phi = std::acos(q(0));
+    if(phi == 0.0)
+        return k_; // DQ(0,0,0,1). This is only a convention;
+    const double s = 1.0/std::sin(phi);
+    return DQ(0, s*q(1), s*q(2), s*q(3));
+}
+
+double UnitDQ::rotation_angle() const
+{
+    return 2.0*std::acos(q(0));
+}
+
+DQ UnitDQ::log() const
+{
+    return log_unchecked();
+}
+
+UnitDQ UnitDQ::pow(const double a) const
+{
+    return UnitDQ(pow_unchecked(a), Unchecked());
+}
+
+UnitDQ UnitDQ::tplus() const
+{
+    return UnitDQ(tplus_unchecked(), Unchecked());
+}
+
+/**
+* The adjoint transformation x*dq2*conj(x), evaluated with a single threshold, see DQ_Expression.h.
+*/
+DQ UnitDQ::Ad(const DQ& dq2) const
+{
+    return lazy(*this)*dq2*DQ_robotics::conj(lazy(*this));
+}
+
+DQ UnitDQ::Adsharp(const DQ& dq2) const
+{
+    return DQ_robotics::sharp(*this)*dq2*conj();
+}
+
+/****************************************************************
+**************NAMESPACE ONLY FUNCTIONS***************************
+*****************************************************************/
+
+/**
+* The product of two unit dual quaternions is a unit dual quaternion.
+*/
+UnitDQ operator*(const UnitDQ& dq1, const UnitDQ& dq2)
+{
+    return UnitDQ::unchecked(static_cast<const DQ&>(dq1)*static_cast<const DQ&>(dq2));
+}
+
+UnitDQ conj(const UnitDQ& dq)
+{
+    return dq.conj();
+}
+
+UnitDQ inv(const UnitDQ& dq)
+{
+    return dq.inv();
+}
+
+UnitDQ rotation(const UnitDQ& dq)
+{
+    return dq.rotation();
+}
+
+DQ translation(const UnitDQ& dq)
+{
+    return dq.translation();
+}
+
+DQ rotation_axis(const UnitDQ& dq)
+{
+    return dq.rotation_axis();
+}
+
+double rotation_angle(const UnitDQ& dq)
+{
+    return dq.rotation_angle();
+}
+
+DQ log(const UnitDQ& dq)
+{
+    return dq.log();
+}
+
+/**
+* @brief unit_exp the exponential of the pure DQ @p dq, which is a unit DQ, without checking that @p dq is pure. Its
+* real part is ignored.
+*/
+UnitDQ unit_exp(const DQ& dq)
+{
+    return UnitDQ::unchecked(exp_unchecked(dq));
+}
+
+UnitDQ pow(const UnitDQ& dq, const double& a)
+{
+    return dq.pow(a);
+}
+
+UnitDQ tplus(const UnitDQ& dq)
+{
+    return dq.tplus();
+}
+
+DQ Ad(const UnitDQ& dq1, const DQ& dq2)
+{
+    return dq1.Ad(dq2);
+}
+
+DQ Adsharp(const UnitDQ& dq1, const DQ& dq2)
+{
+    return dq1.Adsharp(dq2);
+}
+
+UnitDQ normalize(const UnitDQ& dq)
+{
+    return dq;
+}
+
+}
@@ -0,0 +1,429 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/DQ.h>
+#include <dqrobotics/DQ_Expression.h>
+#include <dqrobotics/utils/DQ_Geometry.h>
+#include "dqbench.h"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace DQ_robotics;
+
+static void BM_DQ_product(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+    const DQ b = normalize(DQ(8,7,6,5,4,3,2,1));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a*b);
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_product);
+
+static void BM_DQ_product_chain(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+    DQ x(1);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        x = x*a;
+        benchmark::DoNotOptimize(x);
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_product_chain);
+
+/*
+ * The same chains evaluated eagerly, one thresholded DQ per operator, and through lazy(), thresholded once.
+ */
+static void BM_DQ_chain_eager(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+    const DQ b = normalize(DQ(8,7,6,5,4,3,2,1));
+    const DQ w(0,0,0.6,0.8,0,0,0.3,-0.4);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(conj(b)*a*b);
+        benchmark::DoNotOptimize(0.5*a*w*a.conj());
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_chain_eager);
+
+static void BM_DQ_chain_lazy(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+    const DQ b = normalize(DQ(8,7,6,5,4,3,2,1));
+    const DQ w(0,0,0.6,0.8,0,0,0.3,-0.4);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(eval(conj(lazy(b))*a*b));
+        benchmark::DoNotOptimize(eval(0.5*lazy(a)*w*conj(lazy(a))));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_chain_lazy);
+
+static void BM_DQ_conj(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(conj(a));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_conj);
+
+static void BM_DQ_norm(benchmark::State& state)
+{
+    const DQ a = DQ(1,2,3,4,5,6,7,8);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(norm(a));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_norm);
+
+static void BM_DQ_inv(benchmark::State& state)
+{
+    const DQ a = DQ(1,2,3,4,5,6,7,8);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(inv(a));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_inv);
+
+static void BM_DQ_hamiplus8(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(hamiplus8(a));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_hamiplus8);
+
+static void BM_DQ_haminus8(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(haminus8(a));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_haminus8);
+
+/*
+ * hamiplus8(a)*J and haminus8(a)*J for an 8xn Jacobian J: dense 8x8 products against the structured kernels.
+ */
+static void BM_DQ_hamiplus8_dense_times_matrix(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+    const MatrixXd J = MatrixXd::Random(8,state.range(0));
+    MatrixXd result(8,J.cols());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        result.noalias() = hamiplus8(a)*J;
+        benchmark::DoNotOptimize(result.data());
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_hamiplus8_dense_times_matrix)->Arg(7)->Arg(14)->Arg(64);
+
+static void BM_DQ_hamiplus8_product(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+    const MatrixXd J = MatrixXd::Random(8,state.range(0));
+    MatrixXd result(8,J.cols());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        hamiplus8_product(a,J,result);
+        benchmark::DoNotOptimize(result.data());
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_hamiplus8_product)->Arg(7)->Arg(14)->Arg(64);
+
+static void BM_DQ_haminus8_dense_times_matrix(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+    const MatrixXd J = MatrixXd::Random(8,state.range(0));
+    MatrixXd result(8,J.cols());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        result.noalias() = haminus8(a)*J;
+        benchmark::DoNotOptimize(result.data());
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_haminus8_dense_times_matrix)->Arg(7)->Arg(14)->Arg(64);
+
+static void BM_DQ_haminus8_product(benchmark::State& state)
+{
+    const DQ a = normalize(DQ(1,2,3,4,5,6,7,8));
+    const MatrixXd J = MatrixXd::Random(8,state.range(0));
+    MatrixXd result(8,J.cols());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        haminus8_product(a,J,result);
+        benchmark::DoNotOptimize(result.data());
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_haminus8_product)->Arg(7)->Arg(14)->Arg(64);
+
+/*
+ * The implementations of log(), exp(), and pow() before they were written in closed form, kept as a reference.
+ */
+static DQ dqbench_reference_log(const DQ& x)
+{
+    if(x.norm() != 1)
+        throw std::range_error("Bad log() call: Not a unit dual quaternion");
+    const DQ p = acos(x.q(0))*x.rotation_axis();
+    const DQ d = 0.5*x.translation();
+    return DQ(p.q(0),p.q(1),p.q(2),p.q(3),d.q(0),d.q(1),d.q(2),d.q(3));
+}
+
+static DQ dqbench_reference_exp(const DQ& x)
+{
+    if(x.Re() != 0.0)
+        throw std::range_error("Bad exp() call: Exponential operation is defined only for pure dual quaterions.");
+    DQ prim = x.P();
+    const double phi = prim.q.norm();
+    if(phi != 0.0)
+        prim = cos(phi) + (sin(phi)/phi)*x.P();
+    else
+        prim = DQ(1.0);
+    return prim + E_*x.D()*prim;
+}
+
+static DQ dqbench_unit_dq()
+{
+    const DQ r = cos(0.4) + sin(0.4)*normalize(DQ(0,1,2,3));
+    return r + E_*0.5*DQ(0,0.1,0.2,0.3)*r;
+}
+
+static void BM_DQ_log(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(log(x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_log);
+
+static void BM_DQ_log_unchecked(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(log_unchecked(x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_log_unchecked);
+
+static void BM_DQ_log_reference(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(dqbench_reference_log(x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_log_reference);
+
+static void BM_DQ_exp(benchmark::State& state)
+{
+    const DQ x = log(dqbench_unit_dq());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(exp(x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_exp);
+
+static void BM_DQ_exp_reference(benchmark::State& state)
+{
+    const DQ x = log(dqbench_unit_dq());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(dqbench_reference_exp(x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_exp_reference);
+
+static void BM_DQ_pow(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(pow(x,0.5));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_pow);
+
+static void BM_DQ_pow_unchecked(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(pow_unchecked(x,0.5));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_pow_unchecked);
+
+static void BM_DQ_pow_reference(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(dqbench_reference_exp(0.5*dqbench_reference_log(x)));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_pow_reference);
+
+static void BM_DQ_tplus(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(tplus(x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_tplus);
+
+static void BM_DQ_tplus_unchecked(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(tplus_unchecked(x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_tplus_unchecked);
+
+static void BM_DQ_tplus_reference(benchmark::State& state)
+{
+    const DQ x = dqbench_unit_dq();
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(x*conj(P(x)));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_tplus_reference);
+
+static void BM_DQ_Geometry_point_to_line_squared_distance(benchmark::State& state)
+{
+    const DQ point = DQ(0,1,2,3);
+    const DQ line  = k_ + E_*cross(i_,k_);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Geometry::point_to_line_squared_distance(point,line));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_Geometry_point_to_line_squared_distance);
+
+static void BM_DQ_Geometry_point_to_line_squared_distance_unchecked(benchmark::State& state)
+{
+    const DQ point = DQ(0,1,2,3);
+    const DQ line  = k_ + E_*cross(i_,k_);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Geometry::point_to_line_squared_distance_unchecked(point,line));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_DQ_Geometry_point_to_line_squared_distance_unchecked);
@@ -0,0 +1,125 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include <dqrobotics/robot_modeling/DQ_CooperativeDualTaskSpace.h>
+#include "dqbench.h"
+
+using namespace DQ_robotics;
+
+/**
+ * @brief Two KUKA LWR4s, the second one displaced by 1 m along the x-axis.
+ */
+struct DQBenchTwoArms
+{
+    DQ_SerialManipulator robot1;
+    DQ_SerialManipulator robot2;
+    VectorXd theta;
+
+    DQBenchTwoArms():
+        robot1(KukaLw4Robot::kinematics()),
+        robot2(KukaLw4Robot::kinematics()),
+        theta(VectorXd::LinSpaced(14,-0.7,0.6))
+    {
+        robot2.set_reference_frame(1 + 0.5*E_*i_);
+    }
+};
+
+static void BM_cdts_relative_pose(benchmark::State& state)
+{
+    DQBenchTwoArms arms;
+    DQ_CooperativeDualTaskSpace cdts(&arms.robot1,&arms.robot2);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(cdts.relative_pose(arms.theta));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_cdts_relative_pose);
+
+static void BM_cdts_absolute_pose(benchmark::State& state)
+{
+    DQBenchTwoArms arms;
+    DQ_CooperativeDualTaskSpace cdts(&arms.robot1,&arms.robot2);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(cdts.absolute_pose(arms.theta));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_cdts_absolute_pose);
+
+static void BM_cdts_absolute_pose_jacobian(benchmark::State& state)
+{
+    DQBenchTwoArms arms;
+    DQ_CooperativeDualTaskSpace cdts(&arms.robot1,&arms.robot2);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(cdts.absolute_pose_jacobian(arms.theta));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_cdts_absolute_pose_jacobian);
+
+/*
+ * The pose algebra of the cooperative dual task-space on poses that are already known, relative pose xr =
+ * conj(x2)*x1 and absolute pose x2*xr^0.5, and the inverse of a pose.
+ */
+static void BM_cdts_pose_algebra(benchmark::State& state)
+{
+    DQBenchTwoArms arms;
+    const DQ x1 = arms.robot1.fkm(arms.theta.head(7));
+    const DQ x2 = arms.robot2.fkm(arms.theta.tail(7));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        const DQ xr = conj(x2)*x1;
+        benchmark::DoNotOptimize(x2*pow(xr,0.5));
+        benchmark::DoNotOptimize(inv(xr));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_cdts_pose_algebra);
+
+static void BM_cdts_pose_algebra_unit(benchmark::State& state)
+{
+    DQBenchTwoArms arms;
+    const UnitDQ x1 = arms.robot1.unit_fkm(arms.theta.head(7));
+    const UnitDQ x2 = arms.robot2.unit_fkm(arms.theta.tail(7));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        const UnitDQ xr = conj(x2)*x1;
+        benchmark::DoNotOptimize(x2*pow(xr,0.5));
+        benchmark::DoNotOptimize(inv(xr));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_cdts_pose_algebra_unit);
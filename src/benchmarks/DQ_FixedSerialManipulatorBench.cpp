@@ -0,0 +1,116 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robot_modeling/DQ_FixedSerialManipulator.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include <dqrobotics/robots/ComauSmartSixRobot.h>
+#include "dqbench.h"
+
+using namespace DQ_robotics;
+
+typedef DQ_FixedSerialManipulator<7>                              KukaLw4Fixed;
+typedef DQ_FixedSerialManipulator<6,DQ_DHConvention::standard,7>  ComauSmartSixFixed;
+
+/**
+ * @brief the robot benchmarked with type @p Robot.
+ */
+template<class Robot> static Robot dqbench_fixed_robot();
+template<> KukaLw4Fixed dqbench_fixed_robot<KukaLw4Fixed>()
+{
+    return KukaLw4Fixed(KukaLw4Robot::kinematics());
+}
+template<> ComauSmartSixFixed dqbench_fixed_robot<ComauSmartSixFixed>()
+{
+    return ComauSmartSixFixed(ComauSmartSixRobot::kinematics());
+}
+
+/*
+ * The dynamic counterparts of these benchmarks are BM_fkm, BM_pose_jacobian, and BM_fkm_and_pose_jacobian
+ * in DQ_SerialManipulatorBench.cpp, which use the same configurations.
+ */
+
+template<class Robot>
+static void BM_fixed_fkm(benchmark::State& state)
+{
+    const Robot robot = dqbench_fixed_robot<Robot>();
+    const typename Robot::JointVector q = Robot::JointVector::Constant(0.3);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm(q));
+    }
+    allocations.stop();
+}
+BENCHMARK_TEMPLATE(BM_fixed_fkm, KukaLw4Fixed);
+BENCHMARK_TEMPLATE(BM_fixed_fkm, ComauSmartSixFixed);
+
+template<class Robot>
+static void BM_fixed_pose_jacobian(benchmark::State& state)
+{
+    const Robot robot = dqbench_fixed_robot<Robot>();
+    const typename Robot::JointVector q = Robot::JointVector::Constant(0.3);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.pose_jacobian(q));
+    }
+    allocations.stop();
+}
+BENCHMARK_TEMPLATE(BM_fixed_pose_jacobian, KukaLw4Fixed);
+BENCHMARK_TEMPLATE(BM_fixed_pose_jacobian, ComauSmartSixFixed);
+
+template<class Robot>
+static void BM_fixed_fkm_and_pose_jacobian(benchmark::State& state)
+{
+    const Robot robot = dqbench_fixed_robot<Robot>();
+    const typename Robot::JointVector q = Robot::JointVector::Constant(0.3);
+    typename Robot::PoseJacobian J;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm_and_pose_jacobian(q,J));
+        benchmark::DoNotOptimize(J.data());
+    }
+    allocations.stop();
+}
+BENCHMARK_TEMPLATE(BM_fixed_fkm_and_pose_jacobian, KukaLw4Fixed);
+BENCHMARK_TEMPLATE(BM_fixed_fkm_and_pose_jacobian, ComauSmartSixFixed);
+
+/*
+ * Through the DQ_Kinematics interface, with dynamic-size arguments and virtual dispatch.
+ */
+static void BM_fixed_pose_jacobian_via_kinematics(benchmark::State& state, const DQ_Kinematics& robot)
+{
+    const VectorXd q = VectorXd::Constant(state.range(0),0.3);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.pose_jacobian(q,robot.get_dim_configuration_space()));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fixed_pose_jacobian_via_kinematics, KukaLw4Fixed,       KukaLw4Fixed(KukaLw4Robot::kinematics()))->Arg(7);
+BENCHMARK_CAPTURE(BM_fixed_pose_jacobian_via_kinematics, ComauSmartSixFixed, ComauSmartSixFixed(ComauSmartSixRobot::kinematics()))->Arg(6);
@@ -0,0 +1,87 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robot_modeling/DQ_GenericSerialManipulator.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include "dqbench.h"
+
+using namespace DQ_robotics;
+
+/*
+ * Float against double throughput of the same kinematics. The double-precision DQ_SerialManipulator counterparts are
+ * BM_fkm, BM_pose_jacobian, and BM_batch_fkm in DQ_SerialManipulatorBench.cpp.
+ */
+
+template<typename Scalar>
+static void BM_generic_fkm(benchmark::State& state)
+{
+    const DQ_GenericSerialManipulator<Scalar> robot(KukaLw4Robot::kinematics());
+    const typename DQ_GenericSerialManipulator<Scalar>::JointVector q =
+            DQ_GenericSerialManipulator<Scalar>::JointVector::Constant(robot.get_dim_joints(),Scalar(0.3));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm(q));
+    }
+    allocations.stop();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_generic_fkm, float);
+BENCHMARK_TEMPLATE(BM_generic_fkm, double);
+
+template<typename Scalar>
+static void BM_generic_fkm_and_pose_jacobian(benchmark::State& state)
+{
+    const DQ_GenericSerialManipulator<Scalar> robot(KukaLw4Robot::kinematics());
+    const typename DQ_GenericSerialManipulator<Scalar>::JointVector q =
+            DQ_GenericSerialManipulator<Scalar>::JointVector::Constant(robot.get_dim_joints(),Scalar(0.3));
+    typename DQ_GenericSerialManipulator<Scalar>::PoseJacobian J(8,robot.get_dim_joints());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm_and_pose_jacobian(q,J));
+        benchmark::DoNotOptimize(J.data());
+    }
+    allocations.stop();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_generic_fkm_and_pose_jacobian, float);
+BENCHMARK_TEMPLATE(BM_generic_fkm_and_pose_jacobian, double);
+
+template<typename Scalar>
+static void BM_generic_batch_fkm(benchmark::State& state)
+{
+    const DQ_GenericSerialManipulator<Scalar> robot(KukaLw4Robot::kinematics());
+    const int n_samples = state.range(0);
+    const typename DQ_GenericSerialManipulator<Scalar>::JointMatrix joint_configurations =
+            MatrixXd::Random(robot.get_dim_joints(),n_samples).template cast<Scalar>();
+
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.batch_fkm(joint_configurations));
+    }
+    state.SetItemsProcessed(state.iterations()*n_samples);
+}
+BENCHMARK_TEMPLATE(BM_generic_batch_fkm, float)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_generic_batch_fkm, double)->Arg(10000);
@@ -0,0 +1,175 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robots/Ax18ManipulatorRobot.h>
+#include <dqrobotics/robots/BarrettWamArmRobot.h>
+#include <dqrobotics/robots/ComauSmartSixRobot.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include <dqrobotics/solvers/DQ_InverseKinematicsSolver.h>
+#include <dqrobotics/solvers/DQ_MultiStartInverseKinematicsSolver.h>
+#include "dqbench.h"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace DQ_robotics;
+
+/**
+ * @brief Reachable targets, each with an initial guess up to 0.5 rad away from a configuration that reaches it.
+ */
+struct DQBenchInverseKinematicsProblems
+{
+    std::vector<DQ> desired_poses;
+    std::vector<VectorXd> initial_configurations;
+
+    DQBenchInverseKinematicsProblems(const DQ_SerialManipulator& robot, const int& number_of_problems)
+    {
+        const int n = robot.get_dim_configuration_space()-robot.n_dummy();
+        std::srand(0);
+        for(int i = 0; i < number_of_problems; i++)
+        {
+            const VectorXd q = 2.0*VectorXd::Random(n);
+            desired_poses.push_back(robot.fkm(q));
+            initial_configurations.push_back(q + 0.5*VectorXd::Random(n));
+        }
+    }
+};
+
+/**
+ * @brief Reports the solves per second, the mean number of iterations, and the fraction of converged solves.
+ */
+static void dqbench_report_solves(benchmark::State& state, const int& iterations, const int& converged)
+{
+    state.SetItemsProcessed(state.iterations());
+    state.counters["iterations_per_solve"] = benchmark::Counter(double(iterations)/double(state.iterations()));
+    state.counters["converged"] = benchmark::Counter(double(converged)/double(state.iterations()));
+}
+
+static void BM_ik_solve(benchmark::State& state,
+                        const DQ_SerialManipulator& robot,
+                        const DQ_InverseKinematicsSolver::Method& method,
+                        const DQ_InverseKinematicsSolver::ErrorMetric& error_metric)
+{
+    const DQBenchInverseKinematicsProblems problems(robot,64);
+    DQ_InverseKinematicsSolver solver(robot,method,error_metric);
+    int problem = 0;
+    int iterations = 0;
+    int converged = 0;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        const DQ_InverseKinematicsResult& result = solver.solve(problems.desired_poses[problem],
+                                                                problems.initial_configurations[problem]);
+        iterations += result.iterations;
+        converged += result.converged;
+        problem = (problem+1)%64;
+    }
+    allocations.stop();
+    dqbench_report_solves(state,iterations,converged);
+}
+BENCHMARK_CAPTURE(BM_ik_solve, Ax18ManipulatorRobot/lm_pose, Ax18ManipulatorRobot::kinematics(),
+                  DQ_InverseKinematicsSolver::Method::levenberg_marquardt, DQ_InverseKinematicsSolver::ErrorMetric::pose);
+BENCHMARK_CAPTURE(BM_ik_solve, BarrettWamArmRobot/lm_pose,   BarrettWamArmRobot::kinematics(),
+                  DQ_InverseKinematicsSolver::Method::levenberg_marquardt, DQ_InverseKinematicsSolver::ErrorMetric::pose);
+BENCHMARK_CAPTURE(BM_ik_solve, ComauSmartSixRobot/lm_pose,   ComauSmartSixRobot::kinematics(),
+                  DQ_InverseKinematicsSolver::Method::levenberg_marquardt, DQ_InverseKinematicsSolver::ErrorMetric::pose);
+BENCHMARK_CAPTURE(BM_ik_solve, KukaLw4Robot/lm_pose,         KukaLw4Robot::kinematics(),
+                  DQ_InverseKinematicsSolver::Method::levenberg_marquardt, DQ_InverseKinematicsSolver::ErrorMetric::pose);
+BENCHMARK_CAPTURE(BM_ik_solve, KukaLw4Robot/lm_log,          KukaLw4Robot::kinematics(),
+                  DQ_InverseKinematicsSolver::Method::levenberg_marquardt, DQ_InverseKinematicsSolver::ErrorMetric::log);
+BENCHMARK_CAPTURE(BM_ik_solve, KukaLw4Robot/dls_pose,        KukaLw4Robot::kinematics(),
+                  DQ_InverseKinematicsSolver::Method::damped_least_squares, DQ_InverseKinematicsSolver::ErrorMetric::pose);
+
+/*
+ * Tracking a slowly moving target, each solve warm-starts from the previous solution.
+ */
+static void BM_ik_solve_warm_start(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const int n = robot.get_dim_configuration_space()-robot.n_dummy();
+    std::vector<DQ> trajectory;
+    for(int i = 0; i < 100; i++)
+    {
+        trajectory.push_back(robot.fkm(VectorXd::Constant(n,0.3+0.01*i)));
+    }
+    DQ_InverseKinematicsSolver solver(robot);
+    solver.solve(trajectory[0],VectorXd::Constant(n,0.3));
+    int point = 0;
+    int iterations = 0;
+    int converged = 0;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        const DQ_InverseKinematicsResult& result = solver.solve(trajectory[point]);
+        iterations += result.iterations;
+        converged += result.converged;
+        point = (point+1)%100;
+    }
+    allocations.stop();
+    dqbench_report_solves(state,iterations,converged);
+}
+BENCHMARK_CAPTURE(BM_ik_solve_warm_start, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_ik_solve_warm_start, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+/*
+ * Many seeds for the same target. The single-threaded loop is the baseline of the multi-start solver, whose argument
+ * is the number of threads. Both report wall-clock time.
+ */
+static void BM_ik_seeds_single_threaded_loop(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const int n = robot.get_dim_configuration_space()-robot.n_dummy();
+    const DQ desired_pose = robot.fkm(VectorXd::Constant(n,0.4));
+    std::srand(0);
+    const MatrixXd seeds = M_PI*MatrixXd::Random(n,64);
+    DQ_InverseKinematicsSolver solver(robot);
+    VectorXd seed(n);
+
+    for(auto _ : state)
+    {
+        for(int i = 0; i < seeds.cols(); i++)
+        {
+            seed = seeds.col(i);
+            benchmark::DoNotOptimize(solver.solve(desired_pose,seed).converged);
+        }
+    }
+    state.SetItemsProcessed(state.iterations()*seeds.cols());
+}
+BENCHMARK_CAPTURE(BM_ik_seeds_single_threaded_loop, KukaLw4Robot, KukaLw4Robot::kinematics())->UseRealTime();
+
+static void BM_ik_multi_start(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const int n = robot.get_dim_configuration_space()-robot.n_dummy();
+    const DQ desired_pose = robot.fkm(VectorXd::Constant(n,0.4));
+    std::srand(0);
+    const MatrixXd seeds = M_PI*MatrixXd::Random(n,64);
+    DQ_MultiStartInverseKinematicsSolver solver{DQ_InverseKinematicsSolver(robot)};
+    solver.set_number_of_threads(state.range(0));
+
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(solver.solve(desired_pose,seeds).solutions.data());
+    }
+    state.SetItemsProcessed(state.iterations()*seeds.cols());
+    state.counters["solutions"] = benchmark::Counter(solver.result().solutions.cols());
+}
+BENCHMARK_CAPTURE(BM_ik_multi_start, KukaLw4Robot, KukaLw4Robot::kinematics())->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
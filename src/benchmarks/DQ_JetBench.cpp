@@ -0,0 +1,110 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robot_modeling/DQ_GenericSerialManipulator.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include <dqrobotics/utils/DQ_Jet.h>
+#include "dqbench.h"
+
+using namespace DQ_robotics;
+
+typedef DQ_Jet<double,7> DQBenchJet;
+
+/**
+ * @brief a composite task function of the Kuka LW4 configuration: the logarithm of the pose error w.r.t.
+ * @p desired_pose of the tool point, which is the effector displaced along its z-axis with Ad().
+ */
+template<typename Scalar>
+static Matrix<Scalar,8,1> dqbench_task(const DQ_GenericSerialManipulator<Scalar>& robot,
+                                       const Ref<const typename DQ_GenericSerialManipulator<Scalar>::JointVector>& q,
+                                       const GenericDQ<Scalar>& desired_pose)
+{
+    const GenericDQ<Scalar> x = robot.fkm(q);
+    const GenericDQ<Scalar> tool_offset(Scalar(1), Scalar(0), Scalar(0), Scalar(0), Scalar(0), Scalar(0), Scalar(0), Scalar(0.05));
+    const GenericDQ<Scalar> tool = Ad(x, tool_offset)*x;
+    return log(conj(desired_pose)*tool).q;
+}
+
+static void BM_task_value(benchmark::State& state)
+{
+    const DQ_GenericSerialManipulator<double> robot(KukaLw4Robot::kinematics());
+    const VectorXd q = VectorXd::Constant(7,0.3);
+    const GenericDQ<double> desired_pose = robot.fkm(VectorXd::Constant(7,0.5));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(dqbench_task(robot, q, desired_pose));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_task_value);
+
+/*
+ * The Jacobian of the task, 8x7, by central finite differences: 14 evaluations of the task.
+ */
+static void BM_task_jacobian_central_differences(benchmark::State& state)
+{
+    const DQ_GenericSerialManipulator<double> robot(KukaLw4Robot::kinematics());
+    const GenericDQ<double> desired_pose = robot.fkm(VectorXd::Constant(7,0.5));
+    VectorXd q = VectorXd::Constant(7,0.3);
+    Matrix<double,8,7> J;
+    const double h = 1e-6;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        for(int k = 0; k < 7; k++)
+        {
+            const double qk = q(k);
+            q(k) = qk + h;
+            const Matrix<double,8,1> f_plus = dqbench_task(robot, q, desired_pose);
+            q(k) = qk - h;
+            const Matrix<double,8,1> f_minus = dqbench_task(robot, q, desired_pose);
+            q(k) = qk;
+            J.col(k) = (f_plus - f_minus)/(2.0*h);
+        }
+        benchmark::DoNotOptimize(J.data());
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_task_jacobian_central_differences);
+
+/*
+ * The same Jacobian, exact, in a single evaluation of the task with DQ_Jet scalars.
+ */
+static void BM_task_jacobian_jet(benchmark::State& state)
+{
+    const DQ_GenericSerialManipulator<DQBenchJet> robot(KukaLw4Robot::kinematics());
+    const GenericDQ<DQBenchJet> desired_pose = robot.fkm(Matrix<DQBenchJet,7,1>::Constant(DQBenchJet(0.5)));
+    const VectorXd q = VectorXd::Constant(7,0.3);
+    Matrix<double,8,7> J;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        J = jet_jacobian(dqbench_task(robot, jet_variables<7>(q), desired_pose));
+        benchmark::DoNotOptimize(J.data());
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_task_jacobian_jet);
@@ -0,0 +1,208 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include "dqbench.h"
+
+using namespace DQ_robotics;
+
+/**
+ * @brief The pose, pose Jacobian, and derived robot primitives of the KUKA LWR4 at a
+ * fixed, non-singular configuration, shared by the distance Jacobian benchmarks.
+ */
+struct DQBenchKinematicsFixture
+{
+    DQ x;
+    MatrixXd J;
+    DQ t;
+    MatrixXd Jt;
+    DQ robot_line;
+    MatrixXd Jl;
+    DQ robot_plane;
+    MatrixXd Jpi;
+
+    DQBenchKinematicsFixture()
+    {
+        const DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+        const VectorXd q = VectorXd::Constant(robot.get_dim_configuration_space(),0.3);
+
+        x  = robot.fkm(q);
+        J  = robot.pose_jacobian(q);
+        t  = translation(x);
+        Jt = DQ_Kinematics::translation_jacobian(J,x);
+
+        const DQ r = rotation(x);
+        const DQ l = r*k_*conj(r);
+        robot_line = l + E_*cross(t,l);
+        Jl = DQ_Kinematics::line_jacobian(J,x,k_);
+
+        robot_plane = l + E_*dot(t,l);
+        Jpi = DQ_Kinematics::plane_jacobian(J,x,k_);
+    }
+};
+
+static const DQ dqbench_workspace_point = DQ(0,0.1,0.2,0.3);
+static const DQ dqbench_workspace_line  = i_ + E_*cross(DQ(0,0.1,0.2,0.3),i_);
+static const DQ dqbench_workspace_plane = j_ + E_*0.4;
+
+static void BM_translation_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::translation_jacobian(f.J,f.x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_translation_jacobian);
+
+static void BM_rotation_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::rotation_jacobian(f.J));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_rotation_jacobian);
+
+static void BM_distance_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::distance_jacobian(f.J,f.x));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_distance_jacobian);
+
+static void BM_line_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::line_jacobian(f.J,f.x,k_));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_line_jacobian);
+
+static void BM_plane_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::plane_jacobian(f.J,f.x,k_));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_plane_jacobian);
+
+static void BM_point_to_point_distance_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::point_to_point_distance_jacobian(f.Jt,f.t,dqbench_workspace_point));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_point_to_point_distance_jacobian);
+
+static void BM_point_to_line_distance_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::point_to_line_distance_jacobian(f.Jt,f.t,dqbench_workspace_line));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_point_to_line_distance_jacobian);
+
+static void BM_point_to_plane_distance_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::point_to_plane_distance_jacobian(f.Jt,f.t,dqbench_workspace_plane));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_point_to_plane_distance_jacobian);
+
+static void BM_line_to_point_distance_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::line_to_point_distance_jacobian(f.Jl,f.robot_line,dqbench_workspace_point));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_line_to_point_distance_jacobian);
+
+static void BM_line_to_line_distance_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::line_to_line_distance_jacobian(f.Jl,f.robot_line,dqbench_workspace_line));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_line_to_line_distance_jacobian);
+
+static void BM_plane_to_point_distance_jacobian(benchmark::State& state)
+{
+    const DQBenchKinematicsFixture f;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(DQ_Kinematics::plane_to_point_distance_jacobian(f.Jpi,dqbench_workspace_point));
+    }
+    allocations.stop();
+}
+BENCHMARK(BM_plane_to_point_distance_jacobian);
@@ -0,0 +1,170 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include <dqrobotics/utils/DQ_LinearAlgebra.h>
+#include "dqbench.h"
+
+#include <limits>
+
+using namespace DQ_robotics;
+
+/**
+ * The implementation of pinv() before it used the thin SVD and a workspace, kept as a reference.
+ */
+static MatrixXd dqbench_reference_pinv(const MatrixXd& matrix)
+{
+    int num_rows = matrix.rows();
+    int num_cols = matrix.cols();
+
+    JacobiSVD<MatrixXd> svd(num_cols,num_rows);
+    MatrixXd svd_sigma_inverted = MatrixXd::Zero(num_cols,num_rows);
+
+    svd.compute(matrix, ComputeFullU | ComputeFullV);
+    VectorXd singular_values = svd.singularValues();
+
+    double tol = std::max(num_rows,num_cols)*singular_values(0)*std::numeric_limits<double>::epsilon();
+    for(int i=0;i<singular_values.size();i++)
+    {
+        if(singular_values(i) > tol)
+            svd_sigma_inverted(i,i) = 1/(singular_values(i));
+    }
+    return svd.matrixV() * (svd_sigma_inverted * svd.matrixU().adjoint());
+}
+
+/**
+ * @brief The pose Jacobian of the KUKA LWR4 for 7 columns, and that of two of them side by side, as in
+ * a cooperative dual-arm task, for 14 columns. Both have rank 6.
+ */
+static MatrixXd dqbench_jacobian(const int& cols)
+{
+    const DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+    const MatrixXd J = robot.pose_jacobian(VectorXd::Constant(7,0.3));
+    if(cols == 7)
+        return J;
+    MatrixXd J2(8,14);
+    J2 << J, robot.pose_jacobian(VectorXd::Constant(7,-0.2));
+    return J2;
+}
+
+/**
+ * @brief Reports how far @p pseudo_inverse is from the reference pinv of @p matrix and how well it satisfies
+ * matrix*pseudo_inverse*matrix = matrix. The damped variants differ from both by design.
+ */
+static void dqbench_report_accuracy(benchmark::State& state, const MatrixXd& matrix, const MatrixXd& pseudo_inverse)
+{
+    state.counters["difference_to_reference"] = (pseudo_inverse - dqbench_reference_pinv(matrix)).cwiseAbs().maxCoeff();
+    state.counters["penrose_residual"] = (matrix*pseudo_inverse*matrix - matrix).cwiseAbs().maxCoeff();
+}
+
+static void BM_pinv_reference(benchmark::State& state)
+{
+    const MatrixXd J = dqbench_jacobian(state.range(0));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(dqbench_reference_pinv(J));
+    }
+    allocations.stop();
+    dqbench_report_accuracy(state,J,dqbench_reference_pinv(J));
+}
+BENCHMARK(BM_pinv_reference)->Arg(7)->Arg(14);
+
+static void BM_pinv(benchmark::State& state)
+{
+    const MatrixXd J = dqbench_jacobian(state.range(0));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(pinv(J));
+    }
+    allocations.stop();
+    dqbench_report_accuracy(state,J,pinv(J));
+}
+BENCHMARK(BM_pinv)->Arg(7)->Arg(14);
+
+static void BM_pinv_workspace(benchmark::State& state)
+{
+    const MatrixXd J = dqbench_jacobian(state.range(0));
+    DQ_PseudoinverseWorkspace workspace(J.rows(),J.cols());
+    MatrixXd J_pinv(J.cols(),J.rows());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        pinv(J,workspace,J_pinv);
+        benchmark::DoNotOptimize(J_pinv.data());
+    }
+    allocations.stop();
+    dqbench_report_accuracy(state,J,J_pinv);
+}
+BENCHMARK(BM_pinv_workspace)->Arg(7)->Arg(14);
+
+static void BM_truncated_pinv_workspace(benchmark::State& state)
+{
+    const MatrixXd J = dqbench_jacobian(state.range(0));
+    DQ_PseudoinverseWorkspace workspace(J.rows(),J.cols());
+    MatrixXd J_pinv(J.cols(),J.rows());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        truncated_pinv(J,1e-3,workspace,J_pinv);
+        benchmark::DoNotOptimize(J_pinv.data());
+    }
+    allocations.stop();
+    dqbench_report_accuracy(state,J,J_pinv);
+}
+BENCHMARK(BM_truncated_pinv_workspace)->Arg(7)->Arg(14);
+
+static void BM_damped_pinv(benchmark::State& state)
+{
+    const MatrixXd J = dqbench_jacobian(state.range(0));
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(damped_pinv(J,1e-3));
+    }
+    allocations.stop();
+    dqbench_report_accuracy(state,J,damped_pinv(J,1e-3));
+}
+BENCHMARK(BM_damped_pinv)->Arg(7)->Arg(14);
+
+static void BM_damped_pinv_workspace(benchmark::State& state)
+{
+    const MatrixXd J = dqbench_jacobian(state.range(0));
+    DQ_PseudoinverseWorkspace workspace(J.rows(),J.cols());
+    MatrixXd J_pinv(J.cols(),J.rows());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        damped_pinv(J,1e-3,workspace,J_pinv);
+        benchmark::DoNotOptimize(J_pinv.data());
+    }
+    allocations.stop();
+    dqbench_report_accuracy(state,J,J_pinv);
+}
+BENCHMARK(BM_damped_pinv_workspace)->Arg(7)->Arg(14);
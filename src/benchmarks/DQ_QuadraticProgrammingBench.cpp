@@ -0,0 +1,182 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include <dqrobotics/robot_control/DQ_QuadraticProgrammingController.h>
+#include <dqrobotics/solvers/DQ_ActiveSetQuadraticProgrammingSolver.h>
+#include "dqbench.h"
+
+#include <vector>
+
+using namespace DQ_robotics;
+
+/**
+ * @brief The six faces of a box around the initial end-effector position, with their normals pointing inwards, and
+ * the vector-field inequalities -Jd*u <= eta*(d - d_safe) that keep the end effector away from them.
+ */
+struct DQBenchBox
+{
+    std::vector<DQ> planes;
+    double eta;
+    double safe_distance;
+
+    DQBenchBox(const DQ& center, const double& half_size):
+        eta(1.0),
+        safe_distance(0.01)
+    {
+        const DQ normals[3] = {i_, j_, k_};
+        for(const DQ& n : normals)
+        {
+            planes.push_back(n + E_*(dot(center,n) - half_size));
+            const DQ minus_n = -1.0*n;
+            planes.push_back(minus_n + E_*(dot(center,minus_n) - half_size));
+        }
+    }
+
+    void constraints(const MatrixXd& pose_jacobian, const DQ& pose, MatrixXd& A, VectorXd& b) const
+    {
+        const DQ t = translation(pose);
+        const MatrixXd Jt = DQ_Kinematics::translation_jacobian(pose_jacobian,pose);
+        A.resize(planes.size(),pose_jacobian.cols());
+        b.resize(planes.size());
+        for(int i = 0; i < int(planes.size()); i++)
+        {
+            DQ plane = planes[i];
+            const double d = (dot(t,P(plane)) - D(plane)).q(0);
+            A.row(i) = -DQ_Kinematics::point_to_plane_distance_jacobian(Jt,t,plane);
+            b(i) = eta*(d - safe_distance);
+        }
+    }
+};
+
+/**
+ * @brief The quadratic programs of consecutive control ticks of a KUKA LWR4 whose end effector is driven towards a
+ * pose outside a box: 7 joint velocities, 14 joint velocity limits, and 6 plane constraints.
+ */
+struct DQBenchControlTicks
+{
+    std::vector<MatrixXd> H;
+    std::vector<VectorXd> f;
+    std::vector<MatrixXd> A;
+    std::vector<VectorXd> b;
+
+    explicit DQBenchControlTicks(const int& number_of_ticks)
+    {
+        const DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+        const int n = robot.get_dim_configuration_space();
+        VectorXd q = VectorXd::Constant(n,0.3);
+        const VectorXd xd = vec8(robot.fkm(VectorXd::Constant(n,-0.5)));
+        const DQBenchBox box(translation(robot.fkm(q)),0.1);
+        const double gain = 10.0;
+        const double damping = 0.01;
+        const double sampling_time = 0.002;
+
+        DQ_ActiveSetQuadraticProgrammingSolver solver;
+        MatrixXd J;
+        MatrixXd A_box;
+        VectorXd b_box;
+        const MatrixXd Aeq(0,n);
+        const VectorXd beq(0);
+        for(int tick = 0; tick < number_of_ticks; tick++)
+        {
+            const DQ x = robot.fkm_and_pose_jacobian(q,J);
+            box.constraints(J,x,A_box,b_box);
+
+            MatrixXd A_tick(A_box.rows()+2*n,n);
+            VectorXd b_tick(A_box.rows()+2*n);
+            A_tick << A_box, MatrixXd::Identity(n,n), -MatrixXd::Identity(n,n);
+            b_tick << b_box, VectorXd::Constant(2*n,1.0);
+
+            H.push_back(J.transpose()*J + damping*MatrixXd::Identity(n,n));
+            f.push_back(gain*J.transpose()*(vec8(x) - xd));
+            A.push_back(A_tick);
+            b.push_back(b_tick);
+
+            q += sampling_time*solver.solve_quadratic_program(H.back(),f.back(),A.back(),b.back(),Aeq,beq);
+        }
+    }
+};
+
+/*
+ * The quadratic programs of 100 consecutive ticks, solved in order with and without hot start.
+ */
+static void BM_qp_active_set_solve(benchmark::State& state, const bool& hot_start)
+{
+    const DQBenchControlTicks ticks(100);
+    const MatrixXd Aeq(0,7);
+    const VectorXd beq(0);
+    DQ_ActiveSetQuadraticProgrammingSolver solver;
+    solver.set_hot_start(hot_start);
+    int tick = 0;
+    int iterations = 0;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(solver.solve(ticks.H[tick],ticks.f[tick],ticks.A[tick],ticks.b[tick],Aeq,beq));
+        iterations += solver.iterations();
+        tick = (tick+1)%100;
+    }
+    allocations.stop();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["iterations_per_solve"] = benchmark::Counter(double(iterations)/double(state.iterations()));
+}
+BENCHMARK_CAPTURE(BM_qp_active_set_solve, KukaLw4Robot/hot_start,  true);
+BENCHMARK_CAPTURE(BM_qp_active_set_solve, KukaLw4Robot/cold_start, false);
+
+/*
+ * A full control tick: kinematics, constraints, and the quadratic program.
+ */
+static void BM_qp_controller_tick(benchmark::State& state)
+{
+    const DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+    const int n = robot.get_dim_configuration_space();
+    const VectorXd q_initial = VectorXd::Constant(n,0.3);
+    const VectorXd xd = vec8(robot.fkm(VectorXd::Constant(n,-0.5)));
+    const DQBenchBox box(translation(robot.fkm(q_initial)),0.1);
+
+    DQ_ActiveSetQuadraticProgrammingSolver solver;
+    DQ_QuadraticProgrammingController controller(robot,solver);
+    controller.set_gain(10.0);
+    controller.set_damping(0.01);
+    controller.set_joint_velocity_limits(VectorXd::Constant(n,-1.0),VectorXd::Constant(n,1.0));
+    VectorXd q = q_initial;
+    MatrixXd J;
+    MatrixXd A;
+    VectorXd b;
+    int tick = 0;
+
+    for(auto _ : state)
+    {
+        const DQ x = robot.fkm_and_pose_jacobian(q,J);
+        box.constraints(J,x,A,b);
+        controller.set_inequality_constraint(A,b);
+        q += 0.002*controller.compute_setpoint_control_signal(q,xd);
+        if(++tick == 100)
+        {
+            tick = 0;
+            q = q_initial;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_qp_controller_tick);
@@ -0,0 +1,389 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <dqrobotics/robots/Ax18ManipulatorRobot.h>
+#include <dqrobotics/robots/BarrettWamArmRobot.h>
+#include <dqrobotics/robots/ComauSmartSixRobot.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include <dqrobotics/robot_modeling/DQ_IncrementalFkm.h>
+#include "dqbench.h"
+
+#include <thread>
+
+using namespace DQ_robotics;
+
+/**
+ * @brief a fixed, non-singular configuration for @p robot.
+ */
+static VectorXd dqbench_configuration(const DQ_SerialManipulator& robot)
+{
+    return VectorXd::Constant(robot.get_dim_configuration_space()-robot.n_dummy(),0.3);
+}
+
+static void BM_fkm(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm(q));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fkm, Ax18ManipulatorRobot, Ax18ManipulatorRobot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm, BarrettWamArmRobot,   BarrettWamArmRobot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm, ComauSmartSixRobot,   ComauSmartSixRobot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm, KukaLw4Robot,         KukaLw4Robot::kinematics());
+
+static void BM_pose_jacobian(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.pose_jacobian(q));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_pose_jacobian, Ax18ManipulatorRobot, Ax18ManipulatorRobot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian, BarrettWamArmRobot,   BarrettWamArmRobot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian, ComauSmartSixRobot,   ComauSmartSixRobot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian, KukaLw4Robot,         KukaLw4Robot::kinematics());
+
+static void BM_pose_jacobian_preallocated(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    MatrixXd J(8,q.size());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        robot.pose_jacobian(q,robot.get_dim_configuration_space(),J);
+        benchmark::DoNotOptimize(J.data());
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_pose_jacobian_preallocated, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian_preallocated, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_pose_jacobian_derivative(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    const VectorXd q_dot = dqbench_configuration(robot);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.pose_jacobian_derivative(q,q_dot,robot.get_dim_configuration_space()));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_pose_jacobian_derivative, Ax18ManipulatorRobot, Ax18ManipulatorRobot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian_derivative, BarrettWamArmRobot,   BarrettWamArmRobot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian_derivative, ComauSmartSixRobot,   ComauSmartSixRobot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian_derivative, KukaLw4Robot,         KukaLw4Robot::kinematics());
+
+static void BM_pose_jacobian_derivative_preallocated(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    const VectorXd q_dot = dqbench_configuration(robot);
+    MatrixXd J_dot(8,q.size());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        robot.pose_jacobian_derivative(q,q_dot,robot.get_dim_configuration_space(),J_dot);
+        benchmark::DoNotOptimize(J_dot.data());
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_pose_jacobian_derivative_preallocated, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian_derivative_preallocated, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_fkm_then_pose_jacobian(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm(q));
+        benchmark::DoNotOptimize(robot.pose_jacobian(q));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fkm_then_pose_jacobian, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm_then_pose_jacobian, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_fkm_and_pose_jacobian(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    MatrixXd J;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm_and_pose_jacobian(q,J));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fkm_and_pose_jacobian, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm_and_pose_jacobian, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_fkm_and_pose_jacobian_with_link_poses(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    MatrixXd J;
+    MatrixXd link_poses;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm_and_pose_jacobian(q,J,link_poses));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fkm_and_pose_jacobian_with_link_poses, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm_and_pose_jacobian_with_link_poses, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+// The fused call below also applies the reference frame and the effector to J_dot, which pose_jacobian_derivative()
+// leaves out. The robots in src/robots have identity reference frames and effectors, so both benchmarks return the
+// same matrices, but the fused one still does the two extra transformations. Its speedup is therefore a lower bound.
+static void BM_fkm_then_pose_jacobian_then_derivative(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    const VectorXd q_dot = dqbench_configuration(robot);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm(q));
+        benchmark::DoNotOptimize(robot.pose_jacobian(q));
+        benchmark::DoNotOptimize(robot.pose_jacobian_derivative(q,q_dot,robot.get_dim_configuration_space()));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fkm_then_pose_jacobian_then_derivative, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm_then_pose_jacobian_then_derivative, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_fkm_pose_jacobian_and_derivative(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    const VectorXd q_dot = dqbench_configuration(robot);
+    MatrixXd J;
+    MatrixXd J_dot;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.fkm_pose_jacobian_and_derivative(q,q_dot,J,J_dot));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fkm_pose_jacobian_and_derivative, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm_pose_jacobian_and_derivative, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_fkm_every_link(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        for(int i = 1; i <= robot.get_dim_configuration_space(); i++)
+        {
+            benchmark::DoNotOptimize(robot.fkm(q,i));
+        }
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fkm_every_link, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm_every_link, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_link_poses(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    MatrixXd poses(8,robot.get_dim_configuration_space());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        robot.link_poses(q,poses);
+        benchmark::DoNotOptimize(poses.data());
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_link_poses, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_link_poses, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_pose_jacobian_every_link(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        for(int i = 1; i <= robot.get_dim_configuration_space(); i++)
+        {
+            benchmark::DoNotOptimize(robot.fkm(q,i));
+            benchmark::DoNotOptimize(robot.pose_jacobian(q,i));
+        }
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_pose_jacobian_every_link, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_pose_jacobian_every_link, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_link_poses_and_jacobians(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    const int n_links = robot.get_dim_configuration_space();
+    MatrixXd poses(8,n_links);
+    MatrixXd jacobians(8,n_links*q.size());
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        robot.link_poses_and_jacobians(q,poses,jacobians);
+        benchmark::DoNotOptimize(jacobians.data());
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_link_poses_and_jacobians, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_link_poses_and_jacobians, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+/*
+ * Coordinate-descent pattern: each iteration changes the last-but-two joint and reads the end-effector pose.
+ */
+static void BM_fkm_one_joint_changed(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    VectorXd q = dqbench_configuration(robot);
+    const int joint = q.size()-3;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        q(joint) = -q(joint);
+        benchmark::DoNotOptimize(robot.fkm(q));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_fkm_one_joint_changed, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_fkm_one_joint_changed, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_incremental_fkm_one_joint_changed(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    VectorXd q = dqbench_configuration(robot);
+    const int joint = q.size()-3;
+    DQ_IncrementalFkm incremental_fkm(robot);
+    incremental_fkm.set_configuration(q);
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        q(joint) = -q(joint);
+        incremental_fkm.set_joint(joint,q(joint));
+        benchmark::DoNotOptimize(incremental_fkm.fkm());
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_incremental_fkm_one_joint_changed, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_incremental_fkm_one_joint_changed, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_incremental_fkm_with_joint(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const VectorXd q = dqbench_configuration(robot);
+    DQ_IncrementalFkm incremental_fkm(robot);
+    incremental_fkm.set_configuration(q);
+    double value = 0.0;
+
+    DQBenchAllocationCounter allocations(state);
+    for(auto _ : state)
+    {
+        value = -value + 0.1;
+        benchmark::DoNotOptimize(incremental_fkm.fkm_with_joint(0,value));
+    }
+    allocations.stop();
+}
+BENCHMARK_CAPTURE(BM_incremental_fkm_with_joint, KukaLw4Robot,       KukaLw4Robot::kinematics());
+BENCHMARK_CAPTURE(BM_incremental_fkm_with_joint, ComauSmartSixRobot, ComauSmartSixRobot::kinematics());
+
+static void BM_fkm_loop(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const int n_samples = state.range(0);
+    const MatrixXd theta_matrix = MatrixXd::Random(robot.get_dim_configuration_space()-robot.n_dummy(),n_samples);
+
+    for(auto _ : state)
+    {
+        for(int i=0;i<n_samples;i++)
+        {
+            benchmark::DoNotOptimize(robot.fkm(theta_matrix.col(i)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations()*n_samples);
+}
+BENCHMARK_CAPTURE(BM_fkm_loop, KukaLw4Robot,       KukaLw4Robot::kinematics())->Arg(10000);
+BENCHMARK_CAPTURE(BM_fkm_loop, ComauSmartSixRobot, ComauSmartSixRobot::kinematics())->Arg(10000);
+
+static void BM_batch_fkm(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const int n_samples = state.range(0);
+    const MatrixXd theta_matrix = MatrixXd::Random(robot.get_dim_configuration_space()-robot.n_dummy(),n_samples);
+
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.batch_fkm(theta_matrix));
+    }
+    state.SetItemsProcessed(state.iterations()*n_samples);
+}
+BENCHMARK_CAPTURE(BM_batch_fkm, KukaLw4Robot,       KukaLw4Robot::kinematics())->Arg(10000);
+BENCHMARK_CAPTURE(BM_batch_fkm, ComauSmartSixRobot, ComauSmartSixRobot::kinematics())->Arg(10000);
+
+/**
+ * @brief adds the arguments {n_samples, number_of_threads} for 1, 2, 4, ... threads up to the number of hardware threads.
+ */
+static void dqbench_thread_scaling(benchmark::internal::Benchmark* benchmark)
+{
+    const int n_hardware_threads = std::max(1,static_cast<int>(std::thread::hardware_concurrency()));
+    for(int n_threads = 1; n_threads < n_hardware_threads; n_threads *= 2)
+    {
+        benchmark->Args({10000,n_threads});
+    }
+    benchmark->Args({10000,n_hardware_threads});
+}
+
+static void BM_batch_pose_jacobian(benchmark::State& state, const DQ_SerialManipulator& robot)
+{
+    const int n_samples = state.range(0);
+    const int n_threads = state.range(1);
+    const MatrixXd theta_matrix = MatrixXd::Random(robot.get_dim_configuration_space()-robot.n_dummy(),n_samples);
+
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(robot.batch_pose_jacobian(theta_matrix,robot.get_dim_configuration_space(),n_threads));
+    }
+    state.SetItemsProcessed(state.iterations()*n_samples);
+}
+BENCHMARK_CAPTURE(BM_batch_pose_jacobian, KukaLw4Robot,       KukaLw4Robot::kinematics())->Apply(dqbench_thread_scaling)->UseRealTime();
+BENCHMARK_CAPTURE(BM_batch_pose_jacobian, ComauSmartSixRobot, ComauSmartSixRobot::kinematics())->Apply(dqbench_thread_scaling)->UseRealTime();
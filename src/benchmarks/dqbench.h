@@ -0,0 +1,64 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#ifndef DQ_BENCHMARKS_DQBENCH_H
+#define DQ_BENCHMARKS_DQBENCH_H
+
+#include <cstddef>
+#include <benchmark/benchmark.h>
+
+namespace DQ_robotics
+{
+
+/**
+ * @brief dqbench_allocation_count the number of heap allocations (malloc, calloc,
+ * realloc and aligned allocation calls) made by the current thread since the start of the benchmark
+ * executable.
+ */
+std::size_t dqbench_allocation_count();
+
+/**
+ * @brief Counts the heap allocations made while a benchmark loop runs and reports
+ * them as the "allocs_per_iteration" counter. Construct it right before the
+ * `for(auto _ : state)` loop and call stop() right after it.
+ */
+class DQBenchAllocationCounter
+{
+private:
+    benchmark::State& state_;
+    std::size_t start_count_;
+public:
+    explicit DQBenchAllocationCounter(benchmark::State& state):
+        state_(state),
+        start_count_(dqbench_allocation_count())
+    {}
+
+    void stop()
+    {
+        const double allocations = static_cast<double>(dqbench_allocation_count()-start_count_);
+        state_.counters["allocs_per_iteration"] = benchmark::Counter(allocations/static_cast<double>(state_.iterations()));
+    }
+};
+
+}
+
+#endif
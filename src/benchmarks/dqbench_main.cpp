@@ -0,0 +1,52 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include <cstdlib>
+#include <dqrobotics/utils/DQ_Instrumentation.h>
+#include "dqbench.h"
+
+namespace DQ_robotics
+{
+
+#ifdef DQROBOTICS_INSTRUMENTATION
+/*
+ * The instrumented library hooks the allocators itself, reuse its counter.
+ */
+std::size_t dqbench_allocation_count()
+{
+    return instrumentation_counters().allocations;
+}
+#else
+/*
+ * Otherwise src/utils/DQ_AllocationHooks.cpp is linked into this executable, see CMakeLists.txt.
+ */
+std::size_t heap_allocation_count();
+
+std::size_t dqbench_allocation_count()
+{
+    return heap_allocation_count();
+}
+#endif
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,246 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/robot_control/DQ_QuadraticProgrammingController.h>
+#include<stdexcept>
+
+namespace DQ_robotics
+{
+
+/**
+* Creates a controller of the pose of @p robot with a gain of 1, a damping of 0.001, and no constraints.
+* \param DQ_SerialManipulator robot is the controlled robot. It must outlive the controller.
+* \param DQ_QuadraticProgrammingSolver solver solves the quadratic program of each tick. It must outlive the controller.
+*/
+DQ_QuadraticProgrammingController::DQ_QuadraticProgrammingController(const DQ_SerialManipulator& robot, DQ_QuadraticProgrammingSolver& solver):
+    robot_(&robot),
+    solver_(&solver),
+    control_objective_(ControlObjective::pose),
+    gain_(1.0),
+    damping_(0.001)
+{
+    clear_constraints();
+}
+
+void DQ_QuadraticProgrammingController::set_control_objective(const ControlObjective& control_objective)
+{
+    control_objective_ = control_objective;
+}
+
+DQ_QuadraticProgrammingController::ControlObjective DQ_QuadraticProgrammingController::control_objective() const
+{
+    return control_objective_;
+}
+
+/**
+* Sets the gain of the task error.
+* \param double gain must be positive.
+*/
+void DQ_QuadraticProgrammingController::set_gain(const double& gain)
+{
+    if(gain <= 0.0)
+    {
+        throw std::range_error("Bad set_gain(gain) call: gain must be positive");
+    }
+    gain_ = gain;
+}
+
+double DQ_QuadraticProgrammingController::gain() const
+{
+    return gain_;
+}
+
+/**
+* Sets the damping of the joint velocities, which also makes the Hessian positive definite.
+* \param double damping must be positive.
+*/
+void DQ_QuadraticProgrammingController::set_damping(const double& damping)
+{
+    if(damping <= 0.0)
+    {
+        throw std::range_error("Bad set_damping(damping) call: damping must be positive");
+    }
+    damping_ = damping;
+}
+
+double DQ_QuadraticProgrammingController::damping() const
+{
+    return damping_;
+}
+
+/**
+* Sets the inequality constraint A*u <= b on the joint velocities u, replacing the previous one. Call it at every
+* tick for constraints that depend on the configuration.
+* \param Eigen::MatrixXd A has one row per constraint and one column per joint, it can have zero rows.
+* \param Eigen::VectorXd b has one element per constraint.
+*/
+void DQ_QuadraticProgrammingController::set_inequality_constraint(const MatrixXd& A, const VectorXd& b)
+{
+    if(A.rows() != b.size() || (A.rows() > 0 && A.cols() != robot_->get_dim_configuration_space() - robot_->n_dummy()))
+    {
+        throw std::range_error("Bad set_inequality_constraint(A,b) call: A must have one column per joint and as many rows as b");
+    }
+    inequality_matrix_ = A;
+    inequality_vector_ = b;
+}
+
+/**
+* Sets the equality constraint Aeq*u = beq on the joint velocities u, replacing the previous one.
+* \param Eigen::MatrixXd Aeq has one row per constraint and one column per joint, it can have zero rows.
+* \param Eigen::VectorXd beq has one element per constraint.
+*/
+void DQ_QuadraticProgrammingController::set_equality_constraint(const MatrixXd& Aeq, const VectorXd& beq)
+{
+    if(Aeq.rows() != beq.size() || (Aeq.rows() > 0 && Aeq.cols() != robot_->get_dim_configuration_space() - robot_->n_dummy()))
+    {
+        throw std::range_error("Bad set_equality_constraint(Aeq,beq) call: Aeq must have one column per joint and as many rows as beq");
+    }
+    equality_matrix_ = Aeq;
+    equality_vector_ = beq;
+}
+
+/**
+* Sets the bounds lower <= u <= upper on the joint velocities u.
+*/
+void DQ_QuadraticProgrammingController::set_joint_velocity_limits(const VectorXd& lower, const VectorXd& upper)
+{
+    const int n = robot_->get_dim_configuration_space() - robot_->n_dummy();
+    if(lower.size() != n || upper.size() != n)
+    {
+        throw std::range_error("Bad set_joint_velocity_limits(lower,upper) call: Incorrect number of joint velocities");
+    }
+    lower_joint_velocity_limits_ = lower;
+    upper_joint_velocity_limits_ = upper;
+}
+
+/**
+* Removes the inequality, equality, and joint velocity constraints.
+*/
+void DQ_QuadraticProgrammingController::clear_constraints()
+{
+    const int n = robot_->get_dim_configuration_space() - robot_->n_dummy();
+    inequality_matrix_.resize(0, n);
+    inequality_vector_.resize(0);
+    equality_matrix_.resize(0, n);
+    equality_vector_.resize(0);
+    lower_joint_velocity_limits_.resize(0);
+    upper_joint_velocity_limits_.resize(0);
+}
+
+/**
+* Calculates the task variable and Jacobian of the control objective at @p q.
+*/
+void DQ_QuadraticProgrammingController::update_task_(const VectorXd& q)
+{
+    const DQ x = robot_->fkm_and_pose_jacobian(q, pose_jacobian_);
+
+    switch(control_objective_)
+    {
+    case ControlObjective::pose:
+        task_variable_ = x.q;
+        task_jacobian_ = pose_jacobian_;
+        break;
+    case ControlObjective::translation:
+        task_variable_ = vec4(translation(x));
+        task_jacobian_ = DQ_Kinematics::translation_jacobian(pose_jacobian_, x);
+        break;
+    case ControlObjective::rotation:
+        task_variable_ = vec4(rotation(x));
+        task_jacobian_ = DQ_Kinematics::rotation_jacobian(pose_jacobian_);
+        break;
+    case ControlObjective::distance:
+        task_variable_.resize(1);
+        task_variable_(0) = vec4(translation(x)).squaredNorm();
+        task_jacobian_ = DQ_Kinematics::distance_jacobian(pose_jacobian_, x);
+        break;
+    }
+}
+
+/**
+* Returns the task variable of the control objective at @p q: vec8 of the pose, vec4 of the translation or of the
+* rotation, or the squared distance to the origin.
+*/
+VectorXd DQ_QuadraticProgrammingController::get_task_variable(const VectorXd& q)
+{
+    update_task_(q);
+    return task_variable_;
+}
+
+/**
+* Returns the Jacobian of the task variable at @p q.
+*/
+MatrixXd DQ_QuadraticProgrammingController::get_jacobian(const VectorXd& q)
+{
+    update_task_(q);
+    return task_jacobian_;
+}
+
+/**
+* Calculates the joint velocities that drive the task variable towards @p task_reference while respecting the
+* constraints.
+* \param Eigen::VectorXd q is the joint configuration.
+* \param Eigen::VectorXd task_reference has the size of the task variable, see get_task_variable().
+* \return The joint velocities.
+* \exception Whatever the solver throws, e.g. std::runtime_error for infeasible constraints.
+*/
+VectorXd DQ_QuadraticProgrammingController::compute_setpoint_control_signal(const VectorXd& q, const VectorXd& task_reference)
+{
+    update_task_(q);
+    if(task_reference.size() != task_variable_.size())
+    {
+        throw std::range_error("Bad compute_setpoint_control_signal(q,task_reference) call: task_reference must have the size of the task variable");
+    }
+    task_error_ = task_variable_ - task_reference;
+
+    const int n = task_jacobian_.cols();
+    H_.noalias() = task_jacobian_.transpose()*task_jacobian_;
+    H_.diagonal().array() += damping_;
+    f_.noalias() = gain_*task_jacobian_.transpose()*task_error_;
+
+    //[A; I; -I]*u <= [b; upper; -lower]
+    const int m = inequality_matrix_.rows();
+    const int n_limits = lower_joint_velocity_limits_.size() > 0 ? n : 0;
+    A_.resize(m + 2*n_limits, n);
+    b_.resize(m + 2*n_limits);
+    A_.topRows(m) = inequality_matrix_;
+    b_.head(m) = inequality_vector_;
+    if(n_limits > 0)
+    {
+        A_.middleRows(m, n).setIdentity();
+        A_.bottomRows(n).setIdentity();
+        A_.bottomRows(n) *= -1.0;
+        b_.segment(m, n) = upper_joint_velocity_limits_;
+        b_.tail(n) = -lower_joint_velocity_limits_;
+    }
+
+    return solver_->solve_quadratic_program(H_, f_, A_, b_, equality_matrix_, equality_vector_);
+}
+
+/**
+* Returns the task error, task variable minus reference, of the last call to compute_setpoint_control_signal().
+*/
+const VectorXd& DQ_QuadraticProgrammingController::last_task_error() const
+{
+    return task_error_;
+}
+
+}
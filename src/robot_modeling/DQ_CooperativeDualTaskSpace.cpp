@@ -31,14 +31,14 @@ DQ_CooperativeDualTaskSpace::DQ_CooperativeDualTaskSpace(DQ_Kinematics *robot1,
     robot2_ = robot2;
 }
 
-DQ DQ_CooperativeDualTaskSpace::pose1(const VectorXd &theta)
+UnitDQ DQ_CooperativeDualTaskSpace::pose1(const VectorXd &theta)
 {
-    return robot1_->fkm(theta.head(robot1_->get_dim_configuration_space()));
+    return robot1_->unit_fkm(theta.head(robot1_->get_dim_configuration_space()));
 }
 
-DQ DQ_CooperativeDualTaskSpace::pose2(const VectorXd &theta)
+UnitDQ DQ_CooperativeDualTaskSpace::pose2(const VectorXd &theta)
 {
-    return robot2_->fkm(theta.tail(robot2_->get_dim_configuration_space()));
+    return robot2_->unit_fkm(theta.tail(robot2_->get_dim_configuration_space()));
 }
 
 MatrixXd DQ_CooperativeDualTaskSpace::pose_jacobian1(const VectorXd &theta)
@@ -51,25 +51,26 @@ MatrixXd DQ_CooperativeDualTaskSpace::pose_jacobian2(const VectorXd &theta)
     return robot2_->pose_jacobian(theta.tail(robot2_->get_dim_configuration_space()),robot2_->get_dim_configuration_space());
 }
 
-DQ DQ_CooperativeDualTaskSpace::relative_pose(const VectorXd &theta)
+UnitDQ DQ_CooperativeDualTaskSpace::relative_pose(const VectorXd &theta)
 {
     return conj(pose2(theta))*pose1(theta);
 }
 
-DQ DQ_CooperativeDualTaskSpace::absolute_pose(const VectorXd &theta)
+UnitDQ DQ_CooperativeDualTaskSpace::absolute_pose(const VectorXd &theta)
 {
-    return pose2(theta)*(pow(relative_pose(theta),0.5));
+    const UnitDQ x2 = pose2(theta);
+    return x2*pow(conj(x2)*pose1(theta),0.5);
 }
 
 MatrixXd DQ_CooperativeDualTaskSpace::relative_pose_jacobian(const VectorXd &theta)
 {
     const MatrixXd Jx1 = pose_jacobian1(theta);
-    const DQ       x1  = pose1(theta);
+    const UnitDQ   x1  = pose1(theta);
     const MatrixXd Jx2 = pose_jacobian2(theta);
-    const DQ       x2  = pose2(theta);
+    const UnitDQ   x2  = pose2(theta);
 
     MatrixXd Jxr(8,Jx1.cols()+Jx2.cols());
-    Jxr << (hamiplus8(conj(x2)))*Jx1,haminus8(x1)*C8()*Jx2;
+    Jxr << hamiplus8_product(conj(x2),Jx1),haminus8_product(x1,C8()*Jx2);
     return  Jxr;
 }
 
@@ -77,22 +78,24 @@ MatrixXd DQ_CooperativeDualTaskSpace::absolute_pose_jacobian(const VectorXd &the
 {
     //Preliminaries
     const MatrixXd Jx2 = pose_jacobian2(theta);
-    const DQ       x2  = pose2(theta);
+    const UnitDQ   x2  = pose2(theta);
     const MatrixXd Jxr  = relative_pose_jacobian(theta);
-    const DQ       xr  = relative_pose(theta);
+    const UnitDQ   xr  = relative_pose(theta);
     const MatrixXd Jtr = DQ_Kinematics::translation_jacobian(Jxr,xr);
 
     //Rotation part
-    MatrixXd Jrr2    = 0.5*haminus4(conj(xr.P())*pow(xr.P(),0.5))*Jxr.block(0,0,4,Jxr.cols());
+    const UnitDQ rr  = rotation(xr);
+    const UnitDQ rr2 = pow(rr,0.5);
+    MatrixXd Jrr2    = 0.5*haminus4(conj(rr)*rr2)*Jxr.block(0,0,4,Jxr.cols());
 
     MatrixXd Jxr2(8,Jrr2.cols());
-    Jxr2 << Jrr2, 0.25*(haminus4(pow(xr.P(),0.5))*Jtr + hamiplus4(translation(xr))*Jrr2);
+    Jxr2 << Jrr2, 0.25*(haminus4(rr2)*Jtr + hamiplus4(translation(xr))*Jrr2);
 
     MatrixXd temp(8,robot1_->get_dim_configuration_space()+robot2_->get_dim_configuration_space());
     temp << MatrixXd::Zero(8,robot1_->get_dim_configuration_space()),Jx2;
 
     MatrixXd Jxa(8,robot1_->get_dim_configuration_space()+robot2_->get_dim_configuration_space());
-    Jxa << haminus8(pow(xr,0.5))*(temp) + hamiplus8(x2)*Jxr2;
+    Jxa << haminus8_product(pow(xr,0.5),temp) + hamiplus8_product(x2,Jxr2);
 
     return Jxa;
 }
@@ -47,7 +47,12 @@ DQ DQ_HolonomicBase::raw_fkm(const VectorXd& q) const
 
 DQ DQ_HolonomicBase::fkm(const VectorXd& q) const
 {
-    return raw_fkm(q)*frame_displacement_;
+    return unit_fkm(q);
+}
+
+UnitDQ DQ_HolonomicBase::unit_fkm(const VectorXd& q) const
+{
+    return UnitDQ::unchecked(raw_fkm(q)*frame_displacement_);
 }
 
 MatrixXd DQ_HolonomicBase::raw_pose_jacobian(const VectorXd& q, const int& to_link) const
@@ -85,7 +90,7 @@ MatrixXd DQ_HolonomicBase::raw_pose_jacobian(const VectorXd& q, const int& to_li
 
 MatrixXd DQ_HolonomicBase::pose_jacobian(const VectorXd &q, const int &to_link) const
 {
-    return haminus8(frame_displacement_)*raw_pose_jacobian(q,to_link);
+    return haminus8_product(frame_displacement_,raw_pose_jacobian(q,to_link));
 }
 
 int DQ_HolonomicBase::get_dim_configuration_space() const
@@ -0,0 +1,233 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/robot_modeling/DQ_IncrementalFkm.h>
+#include<algorithm>
+#include<stdexcept>
+
+namespace DQ_robotics
+{
+
+/**
+* Creates an evaluator for @p robot. Nothing is computed until the first call to set_configuration().
+* \param DQ_SerialManipulator robot is the robot whose forward kinematics is evaluated. It must outlive the evaluator.
+*/
+DQ_IncrementalFkm::DQ_IncrementalFkm(const DQ_SerialManipulator& robot):
+    robot_(&robot)
+{
+    reset();
+}
+
+/**
+* Reads the structure of the robot again and discards every cached product. Must be called after the DH parameters
+* or the dummy joints of the robot change.
+*/
+void DQ_IncrementalFkm::reset()
+{
+    n_links_ = robot_->get_dim_configuration_space();
+
+    const VectorXd dummy = robot_->dummy();
+    joint_index_.resize(n_links_);
+    link_index_.clear();
+    for(int i = 0; i < n_links_; i++)
+    {
+        if(dummy(i) == 1.0)
+        {
+            joint_index_[i] = -1;
+        }
+        else
+        {
+            joint_index_[i] = static_cast<int>(link_index_.size());
+            link_index_.push_back(i);
+        }
+    }
+
+    theta_.resize(link_index_.size());
+    link_transforms_.resize(8, n_links_);
+    prefix_.resize(8, n_links_ + 1);
+    suffix_.resize(8, n_links_ + 1);
+    prefix_.col(0) = DQ(1).q;
+    suffix_.col(n_links_) = DQ(1).q;
+    suffix_valid_from_ = n_links_;
+    initialized_ = false;
+}
+
+/**
+* Sets the configuration, recomputing only the links whose joint changed and the prefixes after the first of them.
+* \param Eigen::VectorXd theta_vec is the vector representing the theta joint angles.
+* \return The number of links whose prefix was recomputed, 0 if the configuration did not change.
+*/
+int DQ_IncrementalFkm::set_configuration(const VectorXd& theta_vec)
+{
+    if(theta_vec.size() != theta_.size())
+    {
+        throw std::range_error("Bad set_configuration(theta_vec) call: Incorrect number of joint variables");
+    }
+
+    int first_changed = n_links_;
+    int last_changed  = -1;
+    for(int i = 0; i < n_links_; i++)
+    {
+        const int& joint = joint_index_[i];
+        if(initialized_ && (joint < 0 || theta_vec(joint) == theta_(joint)))
+            continue;
+
+        // Dummy joints are evaluated at zero
+        link_transforms_.col(i) = robot_->dh2dq(joint < 0 ? 0.0 : theta_vec(joint), i+1).q;
+        if(first_changed == n_links_)
+            first_changed = i;
+        last_changed = i;
+    }
+    theta_ = theta_vec;
+    initialized_ = true;
+
+    for(int i = first_changed; i < n_links_; i++)
+    {
+        prefix_.col(i+1) = (DQ(prefix_.col(i)) * DQ(link_transforms_.col(i))).q;
+    }
+    suffix_valid_from_ = std::max(suffix_valid_from_, last_changed + 1);
+
+    return n_links_ - first_changed;
+}
+
+/**
+* Same as set_configuration() with only one joint changed.
+* \param int joint is the index of the joint in the joint vector.
+* \param double value is the new value of the joint.
+* \return The number of links whose prefix was recomputed.
+*/
+int DQ_IncrementalFkm::set_joint(const int& joint, const double& value)
+{
+    if(!initialized_)
+    {
+        throw std::range_error("Bad set_joint(joint,value) call: set_configuration() has not been called");
+    }
+    if(joint < 0 || joint >= theta_.size())
+    {
+        throw std::range_error("Bad set_joint(joint,value) call: joint out of range");
+    }
+    if(value == theta_(joint))
+        return 0;
+
+    const int link = link_index_[joint];
+    theta_(joint) = value;
+    link_transforms_.col(link) = robot_->dh2dq(value, link+1).q;
+    for(int i = link; i < n_links_; i++)
+    {
+        prefix_.col(i+1) = (DQ(prefix_.col(i)) * DQ(link_transforms_.col(i))).q;
+    }
+    suffix_valid_from_ = std::max(suffix_valid_from_, link + 1);
+
+    return n_links_ - link;
+}
+
+const VectorXd& DQ_IncrementalFkm::configuration() const
+{
+    return theta_;
+}
+
+/**
+* Brings the suffixes from column @p down_to on up to date.
+*/
+void DQ_IncrementalFkm::update_suffix_(const int& down_to)
+{
+    for(int i = suffix_valid_from_ - 1; i >= down_to; i--)
+    {
+        suffix_.col(i) = (DQ(link_transforms_.col(i)) * DQ(suffix_.col(i+1))).q;
+    }
+    suffix_valid_from_ = std::min(suffix_valid_from_, down_to);
+}
+
+/**
+* The same as DQ_SerialManipulator::raw_fkm(configuration()), read from the cache.
+*/
+DQ DQ_IncrementalFkm::raw_fkm() const
+{
+    return raw_fkm(n_links_);
+}
+
+/**
+* The same as DQ_SerialManipulator::raw_fkm(configuration(),ith), read from the cache.
+*/
+DQ DQ_IncrementalFkm::raw_fkm(const int& ith) const
+{
+    if(!initialized_)
+    {
+        throw std::range_error("Bad raw_fkm(ith) call: set_configuration() has not been called");
+    }
+    if(ith < 0 || ith > n_links_)
+    {
+        throw std::range_error("Bad raw_fkm(ith) call: ith has to be between 0 and the number of links");
+    }
+    return DQ(prefix_.col(ith));
+}
+
+/**
+* The same as DQ_SerialManipulator::fkm(configuration()).
+*/
+DQ DQ_IncrementalFkm::fkm() const
+{
+    return fkm(n_links_);
+}
+
+/**
+* The same as DQ_SerialManipulator::fkm(configuration(),ith), that is, also including the reference frame and the
+* effector.
+*/
+DQ DQ_IncrementalFkm::fkm(const int& ith) const
+{
+    return robot_->reference_frame() * raw_fkm(ith) * robot_->effector();
+}
+
+/**
+* The raw pose of the last link if @p joint had @p value, without changing the configuration. Costs one link
+* transformation and two products once the suffix after the joint is up to date, which makes it suited to line
+* searches along one joint and to finite differences.
+* \param int joint is the index of the joint in the joint vector.
+* \param double value is the value of the joint.
+* \return The same as DQ_SerialManipulator::raw_fkm() at configuration() with @p joint set to @p value.
+*/
+DQ DQ_IncrementalFkm::raw_fkm_with_joint(const int& joint, const double& value)
+{
+    if(!initialized_)
+    {
+        throw std::range_error("Bad raw_fkm_with_joint(joint,value) call: set_configuration() has not been called");
+    }
+    if(joint < 0 || joint >= theta_.size())
+    {
+        throw std::range_error("Bad raw_fkm_with_joint(joint,value) call: joint out of range");
+    }
+
+    const int link = link_index_[joint];
+    update_suffix_(link + 1);
+    return DQ(prefix_.col(link)) * robot_->dh2dq(value, link+1) * DQ(suffix_.col(link+1));
+}
+
+/**
+* The same as raw_fkm_with_joint(), also including the reference frame and the effector.
+*/
+DQ DQ_IncrementalFkm::fkm_with_joint(const int& joint, const double& value)
+{
+    return robot_->reference_frame() * raw_fkm_with_joint(joint, value) * robot_->effector();
+}
+
+}
@@ -21,6 +21,11 @@ Contributors:
 */
 
 #include<dqrobotics/robot_modeling/DQ_Kinematics.h>
+#include<dqrobotics/utils/DQ_Instrumentation.h>
+#include<dqrobotics/utils/DQ_Parallel.h>
+#include<dqrobotics/utils/DQ_Validation.h>
+
+#include<vector>
 
 namespace DQ_robotics
 {
@@ -40,6 +45,10 @@ DQ_Kinematics::DQ_Kinematics()
 
 void DQ_Kinematics::set_reference_frame(const DQ &reference_frame)
 {
+    if(DQROBOTICS_INPUT_VALIDATION && !is_unit(reference_frame))
+    {
+        throw std::range_error("Bad set_reference_frame(reference_frame) call: Not a unit dual quaternion");
+    }
     reference_frame_ = reference_frame;
 }
 
@@ -68,12 +77,104 @@ std::string DQ_Kinematics::name() const
     return name_;
 }
 
+/* **********************************************************************
+ *  VIRTUAL METHODS WITH A DEFAULT IMPLEMENTATION
+ * *********************************************************************/
+
+/**
+ * @brief unit_fkm the same pose as fkm(), typed as a UnitDQ so that inv(), log(), and pow() skip the unit checks.
+ * @param joint_configurations the joint configurations.
+ * @return UnitDQ(fkm(joint_configurations)), i.e. the result of fkm() normalized once.
+ * The robots in this library override it to skip the normalization, as their reference frame, links, and effector
+ * are all unit dual quaternions.
+ */
+UnitDQ DQ_Kinematics::unit_fkm(const VectorXd &joint_configurations) const
+{
+    return UnitDQ(fkm(joint_configurations));
+}
+
+/**
+ * @brief batch_fkm evaluates fkm() for many independent configurations.
+ * @param joint_configurations a matrix whose i-th column is the i-th configuration.
+ * @return an 8xN matrix whose i-th column is vec8(fkm(joint_configurations.col(i))).
+ * The default implementation calls fkm() once per column, subclasses override it when they can do better.
+ */
+MatrixXd DQ_Kinematics::batch_fkm(const MatrixXd &joint_configurations) const
+{
+    MatrixXd poses(8,joint_configurations.cols());
+    for(int i=0;i<joint_configurations.cols();i++)
+    {
+        poses.col(i) = vec8(fkm(joint_configurations.col(i)));
+    }
+    return poses;
+}
+
+/**
+ * @brief batch_pose_jacobian_kernel_ evaluates the pose Jacobian of a single sample of batch_pose_jacobian().
+ * @param joint_configurations the joint configurations of the sample.
+ * @param to_link the link the Jacobian is calculated to.
+ * @param pose_jacobian the output, it holds the Jacobian of a previous sample of the same worker so that
+ * subclasses can reuse its memory. The default implementation calls pose_jacobian().
+ */
+void DQ_Kinematics::batch_pose_jacobian_kernel_(const VectorXd &joint_configurations, const int &to_link, MatrixXd &pose_jacobian) const
+{
+    pose_jacobian = this->pose_jacobian(joint_configurations,to_link);
+}
+
+/**
+ * @brief batch_pose_jacobian evaluates pose_jacobian() for many independent configurations in parallel.
+ * The samples are split into blocks that are scheduled on a work-stealing thread pool, each worker owns its
+ * scratch memory. Every sample is evaluated by the same code irrespective of the worker, so the result does not
+ * depend on @p number_of_threads.
+ * @param joint_configurations a matrix whose i-th column is the i-th configuration.
+ * @param to_link the link the Jacobians are calculated to.
+ * @param number_of_threads the number of threads, 0 means one per hardware thread.
+ * @return an 8x(m*N) matrix, where m is the number of columns of each Jacobian. Columns [i*m,(i+1)*m) hold
+ * pose_jacobian(joint_configurations.col(i),to_link).
+ */
+MatrixXd DQ_Kinematics::batch_pose_jacobian(const MatrixXd &joint_configurations, const int &to_link, const int &number_of_threads) const
+{
+    const int BLOCK_SIZE = 32;
+    const int n_samples = joint_configurations.cols();
+    if(n_samples == 0)
+        return MatrixXd(8,0);
+
+    //The first sample gives the number of columns of each Jacobian
+    MatrixXd first_jacobian;
+    batch_pose_jacobian_kernel_(joint_configurations.col(0),to_link,first_jacobian);
+    const int m = first_jacobian.cols();
+
+    MatrixXd jacobians(8,m*n_samples);
+    jacobians.leftCols(m) = first_jacobian;
+
+    const int n_tasks   = (n_samples - 1 + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    const int n_workers = parallel_number_of_workers(n_tasks,number_of_threads);
+    std::vector<VectorXd> configuration_scratch(n_workers,VectorXd(joint_configurations.rows()));
+    std::vector<MatrixXd> jacobian_scratch(n_workers,first_jacobian);
+
+    parallel_for(n_tasks,n_workers,[&](const int& task, const int& worker)
+    {
+        VectorXd& configuration = configuration_scratch[worker];
+        MatrixXd& jacobian      = jacobian_scratch[worker];
+        const int end = std::min(n_samples,1+(task+1)*BLOCK_SIZE);
+        for(int i=1+task*BLOCK_SIZE;i<end;i++)
+        {
+            configuration = joint_configurations.col(i);
+            batch_pose_jacobian_kernel_(configuration,to_link,jacobian);
+            jacobians.middleCols(i*m,m) = jacobian;
+        }
+    });
+
+    return jacobians;
+}
+
 /* **********************************************************************
  *  STATIC METHODS
  * *********************************************************************/
 
 MatrixXd DQ_Kinematics::distance_jacobian(const MatrixXd &pose_jacobian, const DQ &pose)
 {
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::distance_jacobian");
     const DQ t        = translation(pose);
     const MatrixXd Jt = DQ_Kinematics::translation_jacobian(pose_jacobian,pose);
     const MatrixXd Jd = 2*vec4(t).transpose()*Jt;
@@ -82,12 +183,14 @@ MatrixXd DQ_Kinematics::distance_jacobian(const MatrixXd &pose_jacobian, const D
 
 MatrixXd DQ_Kinematics::translation_jacobian(const MatrixXd &pose_jacobian, const DQ &pose)
 {
-    return 2.0*haminus4(conj(P(pose)))*pose_jacobian.block(4,0,8,pose_jacobian.cols())+2.0*hamiplus4(D(pose))*C4()*DQ_Kinematics::rotation_jacobian(pose_jacobian);
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::translation_jacobian");
+    return 2.0*haminus4(conj(P(pose)))*pose_jacobian.block(4,0,4,pose_jacobian.cols())+2.0*hamiplus4(D(pose))*C4()*DQ_Kinematics::rotation_jacobian(pose_jacobian);
 }
 
 
 MatrixXd DQ_Kinematics::rotation_jacobian(const MatrixXd &pose_jacobian)
 {
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::rotation_jacobian");
     return pose_jacobian.block(0,0,4,pose_jacobian.cols());
 }
 
@@ -101,6 +204,7 @@ MatrixXd DQ_Kinematics::rotation_jacobian(const MatrixXd &pose_jacobian)
  */
 MatrixXd DQ_Kinematics::line_jacobian(const MatrixXd& pose_jacobian, const DQ& pose, const DQ& line_direction)
 {
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::line_jacobian");
     /// Aliases
     const DQ&       x  = pose;
 
@@ -137,6 +241,7 @@ MatrixXd DQ_Kinematics::line_jacobian(const MatrixXd& pose_jacobian, const DQ& p
  */
 MatrixXd DQ_Kinematics::plane_jacobian(const MatrixXd& pose_jacobian, const DQ& pose, const DQ& plane_normal)
 {
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::plane_jacobian");
     /// Aliases
     const DQ&       x  = pose;
 
@@ -163,11 +268,12 @@ MatrixXd DQ_Kinematics::plane_jacobian(const MatrixXd& pose_jacobian, const DQ&
 
 MatrixXd DQ_Kinematics::point_to_point_distance_jacobian(const MatrixXd& translation_jacobian, const DQ& robot_point, const DQ& workspace_point)
 {
-    if(not is_pure_quaternion(robot_point))
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::point_to_point_distance_jacobian");
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(robot_point))
     {
         throw std::range_error("The argument robot_point has to be a pure quaternion.");
     }
-    if(not is_pure_quaternion(workspace_point))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(workspace_point))
     {
         throw std::range_error("The argument workspace_point has to be a pure quaternion.");
     }
@@ -177,11 +283,11 @@ MatrixXd DQ_Kinematics::point_to_point_distance_jacobian(const MatrixXd& transla
 
 double   DQ_Kinematics::point_to_point_residual         (const DQ& robot_point, const DQ& workspace_point, const DQ& workspace_point_derivative)
 {
-    if(not is_pure_quaternion(robot_point))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(robot_point))
     {
         throw std::range_error("The argument robot_point has to be a pure quaternion.");
     }
-    if(not is_pure_quaternion(workspace_point))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(workspace_point))
     {
         throw std::range_error("The argument workspace_point has to be a pure quaternion.");
     }
@@ -193,11 +299,12 @@ double   DQ_Kinematics::point_to_point_residual         (const DQ& robot_point,
 
 MatrixXd DQ_Kinematics::point_to_line_distance_jacobian(const MatrixXd& translation_jacobian, const DQ& robot_point, const DQ& workspace_line)
 {
-    if(not is_pure_quaternion(robot_point))
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::point_to_line_distance_jacobian");
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(robot_point))
     {
         throw std::range_error("The argument robot_point has to be a pure quaternion.");
     }
-    if(not is_line(workspace_line))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(workspace_line))
     {
         throw std::range_error("The argument workspace_line has to be a line.");
     }
@@ -212,11 +319,11 @@ MatrixXd DQ_Kinematics::point_to_line_distance_jacobian(const MatrixXd& translat
 
 double   DQ_Kinematics::point_to_line_residual(const DQ& robot_point, const DQ& workspace_line, const DQ& workspace_line_derivative)
 {
-    if(not is_pure_quaternion(robot_point))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(robot_point))
     {
         throw std::range_error("The argument robot_point has to be a pure quaternion.");
     }
-    if(not is_line(workspace_line))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(workspace_line))
     {
         throw std::range_error("The argument workspace_line has to be a line.");
     }
@@ -235,11 +342,12 @@ double   DQ_Kinematics::point_to_line_residual(const DQ& robot_point, const DQ&
 
 MatrixXd DQ_Kinematics::point_to_plane_distance_jacobian(const MatrixXd& translation_jacobian, const DQ& robot_point, const DQ& workspace_plane)
 {
-    if(not is_pure_quaternion(robot_point))
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::point_to_plane_distance_jacobian");
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(robot_point))
     {
         throw std::range_error("The argument robot_point has to be a pure quaternion.");
     }
-    if(not is_plane(workspace_plane))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_plane(workspace_plane))
     {
         throw std::range_error("The argument workspace_plane has to be a plane.");
     }
@@ -251,7 +359,7 @@ MatrixXd DQ_Kinematics::point_to_plane_distance_jacobian(const MatrixXd& transla
 
 double DQ_Kinematics::point_to_plane_residual(const DQ& translation, const DQ& plane_derivative)
 {
-    if(not is_pure_quaternion(translation))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(translation))
     {
         throw std::range_error("The argument translation has to be a pure quaternion.");
     }
@@ -266,11 +374,12 @@ double DQ_Kinematics::point_to_plane_residual(const DQ& translation, const DQ& p
 
 MatrixXd DQ_Kinematics::line_to_point_distance_jacobian (const MatrixXd& line_jacobian, const DQ& robot_line, const DQ& workspace_point)
 {
-    if(not is_line(robot_line))
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::line_to_point_distance_jacobian");
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(robot_line))
     {
         throw std::range_error("The argument robot_line has to be a line.");
     }
-    if(not is_pure_quaternion(workspace_point))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(workspace_point))
     {
         throw std::range_error("The argument workspace_point has to be a pure quaternion");
     }
@@ -287,11 +396,11 @@ MatrixXd DQ_Kinematics::line_to_point_distance_jacobian (const MatrixXd& line_ja
 
 double   DQ_Kinematics::line_to_point_residual(const DQ& robot_line, const DQ& workspace_point, const DQ& workspace_point_derivative)
 {
-    if(not is_line(robot_line))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(robot_line))
     {
         throw std::range_error("The argument robot_line has to be a line.");
     }
-    if(not is_pure_quaternion(workspace_point))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(workspace_point))
     {
         throw std::range_error("The argument workspace_point has to be a pure quaternion");
     }
@@ -310,11 +419,12 @@ double   DQ_Kinematics::line_to_point_residual(const DQ& robot_line, const DQ& w
 
 MatrixXd DQ_Kinematics::line_to_line_distance_jacobian(const MatrixXd& line_jacobian, const DQ& robot_line, const DQ& workspace_line)
 {
-    if(not is_line(robot_line))
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::line_to_line_distance_jacobian");
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(robot_line))
     {
         throw std::range_error("The argument robot_line has to be a line.");
     }
-    if(not is_line(workspace_line))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(workspace_line))
     {
         throw std::range_error("The argument workspace_line has to be a line.");
     }
@@ -324,7 +434,7 @@ MatrixXd DQ_Kinematics::line_to_line_distance_jacobian(const MatrixXd& line_jaco
 
     ///Dot product dual part square norm
     //Dot product Jacobian
-    const MatrixXd Jdot     = -0.5*(hamiplus8(l_dq)+haminus8(l_dq))*line_jacobian;
+    const MatrixXd Jdot     = -0.5*(hamiplus8_product(l_dq,line_jacobian)+haminus8_product(l_dq,line_jacobian));
     const MatrixXd Jdotdual = Jdot.block(4,0,4,DOFS);
     //Norm Jacobian
     const DQ Plzldot             = P(dot(robot_line,l_dq));
@@ -333,9 +443,9 @@ MatrixXd DQ_Kinematics::line_to_line_distance_jacobian(const MatrixXd& line_jaco
 
     ///Cross product primary part square norm
     //Cross product Jacobian
-    const MatrixXd Jcross        = 0.5*(haminus8(l_dq)-hamiplus8(l_dq))*line_jacobian;
+    const MatrixXd Jcross        = 0.5*(haminus8_product(l_dq,line_jacobian)-hamiplus8_product(l_dq,line_jacobian));
     const MatrixXd Jcrossprimary = Jcross.block(0,0,4,DOFS);
-    const MatrixXd Jcrossdual    = Jcross.block(5,8,4,DOFS);
+    const MatrixXd Jcrossdual    = Jcross.block(4,0,4,DOFS);
     //Norm Jacobian
     const DQ Plzlcross                = P(cross(robot_line,l_dq));
     const DQ Dlzlcross                = D(cross(robot_line,l_dq));
@@ -368,11 +478,11 @@ MatrixXd DQ_Kinematics::line_to_line_distance_jacobian(const MatrixXd& line_jaco
 
 double   DQ_Kinematics::line_to_line_residual(const DQ& robot_line, const DQ& workspace_line, const DQ& workspace_line_derivative)
 {
-    if(not is_line(robot_line))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(robot_line))
     {
         throw std::range_error("The argument robot_line has to be a line.");
     }
-    if(not is_line(workspace_line))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(workspace_line))
     {
         throw std::range_error("The argument workspace_line has to be a line.");
     }
@@ -418,7 +528,8 @@ double   DQ_Kinematics::line_to_line_residual(const DQ& robot_line, const DQ& wo
 
 MatrixXd DQ_Kinematics::plane_to_point_distance_jacobian(const MatrixXd& plane_jacobian, const DQ& workspace_point)
 {
-    if(not is_pure_quaternion(workspace_point))
+    DQROBOTICS_INSTRUMENT_CALL("DQ_Kinematics::plane_to_point_distance_jacobian");
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(workspace_point))
     {
         throw std::range_error("The argument workspace_point has to be a pure quaternion.");
     }
@@ -433,7 +544,7 @@ MatrixXd DQ_Kinematics::plane_to_point_distance_jacobian(const MatrixXd& plane_j
 
 double   DQ_Kinematics::plane_to_point_residual(const DQ& robot_plane, const DQ& workspace_point_derivative)
 {
-    if(not is_pure_quaternion(workspace_point_derivative))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(workspace_point_derivative))
     {
         throw std::range_error("The argument workspace_point_derivative has to be a pure quaternion.");
     }
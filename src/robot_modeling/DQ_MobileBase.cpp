@@ -21,6 +21,7 @@ Contributors:
 */
 
 #include<dqrobotics/robot_modeling/DQ_MobileBase.h>
+#include<dqrobotics/utils/DQ_Validation.h>
 
 namespace DQ_robotics
 {
@@ -37,6 +38,10 @@ DQ DQ_MobileBase::frame_displacement()
 
 void DQ_MobileBase::set_frame_displacement(const DQ &pose)
 {
+    if(DQROBOTICS_INPUT_VALIDATION && !is_unit(pose))
+    {
+        throw std::range_error("Bad set_frame_displacement(pose) call: Not a unit dual quaternion");
+    }
     frame_displacement_ = pose;
 }
 
@@ -22,7 +22,10 @@ Contributors:
 */
 
 #include<dqrobotics/robot_modeling/DQ_SerialManipulator.h>
+#include<dqrobotics/utils/DQ_Instrumentation.h>
+#include<dqrobotics/utils/DQ_Validation.h>
 #include<dqrobotics/DQ.h>
+#include<dqrobotics/DQ_Expression.h>
 
 namespace DQ_robotics
 {
@@ -61,6 +64,57 @@ DQ_SerialManipulator::DQ_SerialManipulator(const MatrixXd& dh_matrix, const std:
     dh_matrix_ = dh_matrix;
     curr_effector_ = DQ(1);
     dh_matrix_convention_ = convention;
+
+    update_link_parameters_();
+}
+
+DQ_SerialManipulator::DQ_SerialManipulator():DQ_Kinematics()
+{
+    curr_effector_ = DQ(1);
+    dh_matrix_convention_ = "standard";
+
+    update_link_parameters_();
+}
+
+/**
+* Precomputes, for each link, the half-angle sines and cosines of alpha, a/2, d/2, and the index of the link's joint in
+* the joint vector, together with the DH convention. fkm and the Jacobians read only from these, so this must be called
+* whenever dh_matrix_ or dh_matrix_convention_ change.
+*/
+void DQ_SerialManipulator::update_link_parameters_()
+{
+    convention_ = (dh_matrix_convention_ == "modified") ? DQ_DHConvention::modified : DQ_DHConvention::standard;
+
+    links_.resize(dh_matrix_.cols());
+    n_dummy_ = 0;
+    for(int i = 0; i < dh_matrix_.cols(); i++)
+    {
+        int joint_index = i - n_dummy_;
+        if(dh_matrix_.rows() > 4 && dh_matrix_(4,i) == 1.0)
+        {
+            joint_index = -1;
+            n_dummy_++;
+        }
+        links_[i] = dh_kernels::link_parameters<double>(dh_matrix_(0,i), dh_matrix_(1,i), dh_matrix_(2,i), dh_matrix_(3,i), joint_index);
+    }
+}
+
+/**
+* Returns the number of (non-dummy) joints among the first to_link links.
+*/
+int DQ_SerialManipulator::n_joints_up_to_(const int& to_link) const
+{
+    if(to_link < 0 || to_link > this->get_dim_configuration_space())
+    {
+        throw std::range_error("The argument to_link has to be between 0 and the number of links.");
+    }
+    int n_joints = 0;
+    for(int i = 0; i < to_link; i++)
+    {
+        if(links_[i].joint_index >= 0)
+            n_joints++;
+    }
+    return n_joints;
 }
 
 // Public constant methods
@@ -188,6 +242,7 @@ void DQ_SerialManipulator::set_dummy( const VectorXd& dummy_vector)
         for (int i = 0; i < dh_matrix_.cols(); i++) {
             dh_matrix_(4,i) = dummy_vector(i);
         }
+        update_link_parameters_();
     }
     else{
         std::cerr << std::endl << "Kinematics body has no dummy information to change." << std::endl;
@@ -206,16 +261,7 @@ void DQ_SerialManipulator::set_dummy( const VectorXd& dummy_vector)
 */
 int  DQ_SerialManipulator::n_dummy() const
 {
-    int aux_n_dummy = 0;
-    if (dh_matrix_.rows() > 4){
-        for (int i = 0; i < dh_matrix_.cols(); i++) {
-            if(dh_matrix_(4,i) == 1.0)
-                aux_n_dummy = aux_n_dummy + 1;
-        }
-        return aux_n_dummy;
-    }
-    else
-        return aux_n_dummy;
+    return n_dummy_;
 }
 
 /**
@@ -246,6 +292,10 @@ DQ  DQ_SerialManipulator::effector() const
 */
 DQ  DQ_SerialManipulator::set_effector( const DQ& new_effector)
 {
+    if(DQROBOTICS_INPUT_VALIDATION && !is_unit(new_effector))
+    {
+        throw(std::range_error("Bad set_effector(new_effector) call: Not a unit dual quaternion"));
+    }
     curr_effector_ = new_effector;
     return curr_effector_;
 }
@@ -260,23 +310,14 @@ DQ  DQ_SerialManipulator::set_effector( const DQ& new_effector)
 */
 DQ  DQ_SerialManipulator::raw_fkm( const VectorXd& theta_vec) const
 {
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::raw_fkm");
 
     if(int(theta_vec.size()) != (this->get_dim_configuration_space() - this->n_dummy()) )
     {
         throw(std::range_error("Bad raw_fkm(theta_vec) call: Incorrect number of joint variables"));
     }
 
-    DQ q(1);
-    int j = 0;
-    for (int i = 0; i < this->get_dim_configuration_space(); i++) {
-        if(this->dummy()(i) == 1.0) {
-            q = q * dh2dq(0.0, i+1);
-            j = j + 1;
-        }
-        else
-            q = q * dh2dq(theta_vec(i-j), i+1);
-    }
-    return q;
+    return raw_fkm(theta_vec, this->get_dim_configuration_space());
 }
 
 /**
@@ -290,22 +331,15 @@ DQ  DQ_SerialManipulator::raw_fkm( const VectorXd& theta_vec) const
 */
 DQ  DQ_SerialManipulator::raw_fkm( const VectorXd& theta_vec, const int& ith) const
 {
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::raw_fkm");
 
     if(int(theta_vec.size()) != (this->get_dim_configuration_space() - this->n_dummy()) )
     {
         throw(std::range_error("Bad raw_fkm(theta_vec,ith) call: Incorrect number of joint variables"));
     }
 
-    DQ q(1);
-    int j = 0;
-    for (int i = 0; i < ith; i++) {
-        if(this->dummy()(i) == 1.0) {
-            q = q * dh2dq(0, i+1);
-            j = j + 1;
-        }
-        else
-            q = q * dh2dq(theta_vec(i-j), i+1);
-    }
+    DQ q;
+    dh_kernels::raw_fkm_and_joint_axes(links_.data(), ith, convention_, theta_vec, q.q.data());
     return q;
 }
 
@@ -318,8 +352,19 @@ DQ  DQ_SerialManipulator::raw_fkm( const VectorXd& theta_vec, const int& ith) co
 */
 DQ  DQ_SerialManipulator::fkm( const VectorXd& theta_vec) const
 {
-    DQ q = reference_frame_ * ( this->raw_fkm(theta_vec) ) * curr_effector_;
-    return q;
+    return unit_fkm(theta_vec);
+}
+
+/**
+* The same as fkm(theta_vec), typed as a UnitDQ. set_reference_frame() and set_effector() only accept unit dual quaternions,
+* so the result is not normalized again.
+* \param Eigen::VectorXd theta_vec is the vector representing the theta joint angles.
+* \return A constant UnitDQ object.
+*/
+UnitDQ DQ_SerialManipulator::unit_fkm( const VectorXd& theta_vec) const
+{
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::fkm");
+    return UnitDQ::unchecked(lazy(reference_frame_) * this->raw_fkm(theta_vec) * curr_effector_);
 }
 
 
@@ -330,10 +375,10 @@ DQ  DQ_SerialManipulator::fkm( const VectorXd& theta_vec) const
 * \param Eigen::VectorXd theta_vec is the vector representing the theta joint angles.
 * \return A constant DQ object.
 */
-DQ  DQ_SerialManipulator::fkm( const VectorXd& theta_vec, const int& ith) const
+UnitDQ DQ_SerialManipulator::fkm( const VectorXd& theta_vec, const int& ith) const
 {
-    DQ q = reference_frame_ * ( this->raw_fkm(theta_vec, ith) ) * curr_effector_;
-    return q;
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::fkm");
+    return UnitDQ::unchecked(lazy(reference_frame_) * this->raw_fkm(theta_vec, ith) * curr_effector_);
 }
 
 /** Returns the correspondent DQ object, for a given link's Denavit Hartenberg parameters.
@@ -343,104 +388,296 @@ DQ  DQ_SerialManipulator::fkm( const VectorXd& theta_vec, const int& ith) const
 * \return A constant DQ object
 */
 DQ  DQ_SerialManipulator::dh2dq( const double& theta_ang, const int& link_i) const {
+    return dh2dq_(theta_ang, links_[link_i-1]);
+}
 
-    Matrix<double,8,1> q(8);
+/** Returns the correspondent DQ object, for a given link's precomputed Denavit Hartenberg parameters.
+* \param double theta_ang is the joint angle
+* \param LinkParameters link are the link's parameters, see update_link_parameters_()
+* \return A constant DQ object
+*/
+DQ  DQ_SerialManipulator::dh2dq_( const double& theta_ang, const LinkParameters& link) const {
+    DQ dq;
+    dh_kernels::dh2dq(theta_ang, link, convention_, dq.q.data());
+    return dq;
+}
 
-    double d     = this->d()(link_i-1);
-    double a     = this->a()(link_i-1);
-    double alpha = this->alpha()(link_i-1);
 
-    if(this->convention() == "standard") {
+DQ  DQ_SerialManipulator::get_z( const Ref<const VectorXd>& q) const
+{
+    DQ z;
+    dh_kernels::standard_joint_axis(q.data(), z.q.data());
+    return z;
+}
+
 
-        q(0)=cos((theta_ang + this->theta()(link_i-1) )/2.0)*cos(alpha/2.0);
-        q(1)=cos((theta_ang + this->theta()(link_i-1) )/2.0)*sin(alpha/2.0);
-        q(2)=sin((theta_ang + this->theta()(link_i-1) )/2.0)*sin(alpha/2.0);
-        q(3)=sin((theta_ang + this->theta()(link_i-1) )/2.0)*cos(alpha/2.0);
-        double d2=d/2.0;
-        double a2=a/2.0;
-        q(4)= -d2*q(3) - a2*q(1);
-        q(5)= -d2*q(2) + a2*q(0);
-        q(6)=  d2*q(1) + a2*q(3);
-        q(7)=  d2*q(0) - a2*q(2);
+/**
+* Evaluates, in a single sweep through the first to_link links, the raw forward kinematics and the axis of each joint
+* w.r.t. the base. The displacements due to the base and the effector are not taken into account.
+* \param Eigen::VectorXd theta_vec is the vector representing the theta joint angles.
+* \param int to_link is the number of links taken into account.
+* \param Eigen::Ref<MatrixXd> joint_axes must be 8x(number of joints up to to_link) and receives vec8 of each joint's axis.
+* \param Eigen::Ref<MatrixXd> link_poses if not null, must be 8xto_link and receives in its i-th column the raw pose of link i+1.
+* \return The raw pose of link to_link, that is, raw_fkm(theta_vec,to_link).
+*/
+DQ DQ_SerialManipulator::raw_fkm_and_joint_axes_(const VectorXd& theta_vec, const int& to_link, Ref<MatrixXd> joint_axes, Ref<MatrixXd>* link_poses) const
+{
+    if(int(theta_vec.size()) != (this->get_dim_configuration_space() - this->n_dummy()) )
+    {
+        throw(std::range_error("Bad raw_pose_jacobian(theta_vec,to_link) call: Incorrect number of joint variables"));
     }
-    else{
 
-        double h1 = cos((theta_ang + this->theta()(link_i-1) )/2.0)*cos(alpha/2.0);
-        double h2 = cos((theta_ang + this->theta()(link_i-1) )/2.0)*sin(alpha/2.0);
-        double h3 = sin((theta_ang + this->theta()(link_i-1) )/2.0)*sin(alpha/2.0);
-        double h4 = sin((theta_ang + this->theta()(link_i-1) )/2.0)*cos(alpha/2.0);
-        q(0)= h1;
-        q(1)= h2;
-        q(2)= -h3;
-        q(3)= h4;
-        double d2=d/2.0;
-        double a2=a/2.0;
-        q(4)=-d2*h4 - a2*h2;
-        q(5)=-d2*h3 + a2*h1;
-        q(6)=-(d2*h2 + a2*h4);
-        q(7)=d2*h1 - a2*h3;
+    DQ q;
+    dh_kernels::raw_fkm_and_joint_axes(links_.data(), to_link, convention_, theta_vec, q.q.data(),
+                                       joint_axes.data(), joint_axes.outerStride(),
+                                       link_poses ? link_poses->data() : nullptr, link_poses ? link_poses->outerStride() : 8);
+    return q;
+}
+
+/**
+* Evaluates, in a single sweep through the first to_link links, the raw forward kinematics and the raw pose Jacobian.
+* The sweep stores each joint's axis w.r.t. the base in its column; once the last pose is known every column is
+* multiplied on the right by it. The displacements due to the base and the effector are not taken into account.
+* \param Eigen::Ref<MatrixXd> pose_jacobian must be 8x(number of joints up to to_link) and receives the raw Jacobian.
+* \see raw_fkm_and_joint_axes_() for the other parameters.
+* \return The raw pose of link to_link, that is, raw_fkm(theta_vec,to_link).
+*/
+DQ DQ_SerialManipulator::raw_fkm_and_pose_jacobian_(const VectorXd& theta_vec, const int& to_link, Ref<MatrixXd> pose_jacobian, Ref<MatrixXd>* link_poses) const
+{
+    const DQ q = raw_fkm_and_joint_axes_(theta_vec, to_link, pose_jacobian, link_poses);
+    dh_kernels::joint_axes_to_pose_jacobian<double>(nullptr, q.q.data(), pose_jacobian.cols(), pose_jacobian.data(), pose_jacobian.outerStride());
+    return q;
+}
+
+/**
+* Calculates the forward kinematic model for many independent joint configurations.
+* The configurations are processed in blocks stored as structure of arrays, so that the trigonometric functions in
+* dh2dq and the dual quaternion products are evaluated for a whole block of samples at a time.
+* The displacements due to the base and the effector are taken into account, as in fkm(theta_vec).
+* \param Eigen::MatrixXd theta_matrix is a (links - n_dummy)xN matrix whose columns are the joint configurations.
+* \return A constant Eigen::MatrixXd (8,N) whose i-th column is vec8(fkm(theta_matrix.col(i))).
+*/
+MatrixXd DQ_SerialManipulator::batch_fkm(const MatrixXd& theta_matrix) const
+{
+    if(int(theta_matrix.rows()) != (this->get_dim_configuration_space() - this->n_dummy()) )
+    {
+        throw(std::range_error("Bad batch_fkm(theta_matrix) call: Incorrect number of joint variables"));
     }
-    return DQ(q);
+
+    MatrixXd poses(8,theta_matrix.cols());
+    dh_kernels::batch_fkm(links_.data(), get_dim_configuration_space(), convention_,
+                          reference_frame_.q.data(), curr_effector_.q.data(), theta_matrix, poses);
+
+    // using threshold to verify zero values in DQ to be returned
+    poses = (poses.array().abs() < DQ_threshold).select(0.0, poses);
+
+    return poses;
 }
 
+MatrixXd DQ_SerialManipulator::raw_pose_jacobian(const VectorXd& theta_vec, const int& to_link) const
+{
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::raw_pose_jacobian");
+    MatrixXd J(8, n_joints_up_to_(to_link));
+    raw_pose_jacobian(theta_vec, to_link, J);
+    return J;
+}
 
-DQ  DQ_SerialManipulator::get_z( const VectorXd& q) const
+/**
+* Same as raw_pose_jacobian(theta_vec,to_link), but writes into memory supplied by the caller. Nothing is allocated.
+* \param Eigen::Ref<MatrixXd> pose_jacobian must be 8x(number of joints up to to_link) and receives the raw Jacobian.
+*/
+void DQ_SerialManipulator::raw_pose_jacobian(const VectorXd& theta_vec, const int& to_link, Ref<MatrixXd> pose_jacobian) const
 {
-    Matrix<double,8,1> z(8);
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::raw_pose_jacobian");
+    if(pose_jacobian.rows() != 8 || pose_jacobian.cols() != n_joints_up_to_(to_link))
+    {
+        throw(std::range_error("Bad raw_pose_jacobian(theta_vec,to_link,pose_jacobian) call: Incorrect size of pose_jacobian"));
+    }
+    raw_fkm_and_pose_jacobian_(theta_vec, to_link, pose_jacobian, nullptr);
+}
 
-    z(0) = 0.0;
-    z(1)=q(1)*q(3) + q(0)*q(2);
-    z(2)=q(2)*q(3) - q(0)* q(1);
-    z(3)=(q(3)*q(3)-q(2)*q(2)-q(1)*q(1)+q(0)*q(0))/2.0;
-    z(4)=0.0;
-    z(5)=q(1)*q(7)+q(5)*q(3)+q(0)*q(6)+q(4)*q(2);
-    z(6)=q(2)*q(7)+q(6)*q(3)-q(0)*q(5)-q(4)*q(1);
-    z(7)=q(3)*q(7)-q(2)*q(6)-q(1)*q(5)+q(0)*q(4);
+/**
+* Folds, column by column, the reference frame and, if to_link is the last link, the effector into a raw pose Jacobian.
+* This is the same as hamiplus8(reference_frame_)*haminus8(curr_effector_)*pose_jacobian, evaluated in place with the
+* structured products, see hamiplus8_product().
+*/
+void DQ_SerialManipulator::raw_to_pose_jacobian_(const int& to_link, Ref<MatrixXd> pose_jacobian) const
+{
+    hamiplus8_product(reference_frame_, pose_jacobian, pose_jacobian);
+    if(to_link == this->get_dim_configuration_space())
+    {
+        haminus8_product(curr_effector_, pose_jacobian, pose_jacobian);
+    }
+}
 
-    return DQ(z);
+/**
+* Calculates, in a single sweep through the chain, the forward kinematic model and the pose Jacobian.
+* The results are the same as fkm(theta_vec) and pose_jacobian(theta_vec), but the chain is traversed once instead of
+* three times. If pose_jacobian already has the right size it is not reallocated.
+* \param Eigen::VectorXd theta_vec is the vector representing the theta joint angles.
+* \param Eigen::MatrixXd pose_jacobian receives the 8x(links - n_dummy) pose Jacobian.
+* \return A constant DQ object representing the pose of the end effector.
+*/
+UnitDQ DQ_SerialManipulator::fkm_and_pose_jacobian(const VectorXd& theta_vec, MatrixXd& pose_jacobian) const
+{
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::fkm_and_pose_jacobian");
+    pose_jacobian.resize(8, get_dim_configuration_space() - n_dummy());
+    const DQ x = raw_fkm_and_pose_jacobian_(theta_vec, get_dim_configuration_space(), pose_jacobian, nullptr);
+
+    raw_to_pose_jacobian_(get_dim_configuration_space(), pose_jacobian);
+    return UnitDQ::unchecked(lazy(reference_frame_) * x * curr_effector_);
 }
 
+/**
+* Same as fkm_and_pose_jacobian(theta_vec,pose_jacobian), but also returns the intermediate poses computed in the sweep.
+* \param Eigen::MatrixXd link_poses receives an 8xlinks matrix whose i-th column is vec8 of the pose of link i+1 w.r.t.
+* the reference frame. The effector is not taken into account in these poses.
+*/
+UnitDQ DQ_SerialManipulator::fkm_and_pose_jacobian(const VectorXd& theta_vec, MatrixXd& pose_jacobian, MatrixXd& link_poses) const
+{
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::fkm_and_pose_jacobian");
+    pose_jacobian.resize(8, get_dim_configuration_space() - n_dummy());
+    link_poses.resize(8, get_dim_configuration_space());
+    Ref<MatrixXd> link_poses_ref(link_poses);
+    const DQ x = raw_fkm_and_pose_jacobian_(theta_vec, get_dim_configuration_space(), pose_jacobian, &link_poses_ref);
+
+    raw_to_pose_jacobian_(get_dim_configuration_space(), pose_jacobian);
+    for(int i = 0; i < link_poses.cols(); i++) {
+        link_poses.col(i) = (reference_frame_ * DQ(link_poses.col(i))).q;
+    }
+    return UnitDQ::unchecked(lazy(reference_frame_) * x * curr_effector_);
+}
 
-MatrixXd DQ_SerialManipulator::raw_pose_jacobian(const VectorXd& theta_vec, const int& to_link) const
+/**
+* Calculates, in a single sweep through the chain, the forward kinematic model, the pose Jacobian, and its time
+* derivative. The results are the same as fkm(theta_vec), pose_jacobian(theta_vec) and the time derivative of the latter.
+* Differently from pose_jacobian_derivative(), which returns the derivative of raw_pose_jacobian(), the derivative
+* returned here takes the reference frame and the effector into account, so it matches the returned pose_jacobian.
+* The link transforms and joint axes are computed once and shared by the three results, see
+* pose_jacobian_derivative(theta_vec,theta_vec_dot,to_link,pose_jacobian_derivative) for the formula, so the cost is
+* linear in the number of joints. If the output matrices already have the right size they are not reallocated.
+* \param Eigen::VectorXd theta_vec is the vector representing the theta joint angles.
+* \param Eigen::VectorXd theta_vec_dot is the vector of joint velocities.
+* \param Eigen::MatrixXd pose_jacobian receives the 8x(links - n_dummy) pose Jacobian.
+* \param Eigen::MatrixXd pose_jacobian_derivative receives the 8x(links - n_dummy) time derivative of pose_jacobian.
+* \return A constant DQ object representing the pose of the end effector.
+*/
+UnitDQ DQ_SerialManipulator::fkm_pose_jacobian_and_derivative(const VectorXd& theta_vec, const VectorXd& theta_vec_dot, MatrixXd& pose_jacobian, MatrixXd& pose_jacobian_derivative) const
 {
-    DQ q_effector = this->raw_fkm(theta_vec,to_link);
-    DQ z;
-    DQ q(1);
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::fkm_pose_jacobian_and_derivative");
+    if(int(theta_vec_dot.size()) != (this->get_dim_configuration_space() - this->n_dummy()) )
+    {
+        throw(std::range_error("Bad fkm_pose_jacobian_and_derivative(theta_vec,theta_vec_dot,pose_jacobian,pose_jacobian_derivative) call: Incorrect number of joint velocities"));
+    }
 
-    MatrixXd J(8,(to_link - this->n_dummy()) );
+    const int n = get_dim_configuration_space();
+    pose_jacobian.resize(8, n - n_dummy());
+    pose_jacobian_derivative.resize(8, n - n_dummy());
 
-    for (int i = 0; i < J.rows(); i++) {
-        for(int j = 0; j < J.cols(); j++) {
-            J(i,j) = 0;
-        }
+    MatrixXd& J = pose_jacobian;
+    MatrixXd& J_dot = pose_jacobian_derivative;
+    const DQ x = raw_fkm_and_joint_axes_(theta_vec, n, J, nullptr);
+
+    DQ s(0);
+    for(int j = 0; j < J.cols(); j++) {
+        s = lazy(s) + theta_vec_dot(j) * lazy(DQ(J.col(j)));
+    }
+
+    // With J_j = z_j*x, the derivative column s_j*z_j*x + z_j*(conj(s_j) + s)*x becomes s_j*J_j + z_j*((conj(s_j) + s)*x)
+    DQ s_j(0);
+    for(int j = 0; j < J.cols(); j++) {
+        const DQ z(J.col(j));
+        const DQ J_j = z * x;
+        J_dot.col(j) = eval(s_j * lazy(J_j) + z * ((conj(lazy(s_j)) + s) * x)).q;
+        J.col(j) = J_j.q;
+        s_j = lazy(s_j) + theta_vec_dot(j) * lazy(z);
     }
 
-    int ith = -1;
-    for(int i = 0; i < to_link; i++) {
+    raw_to_pose_jacobian_(n, J);
+    raw_to_pose_jacobian_(n, J_dot);
+    return UnitDQ::unchecked(lazy(reference_frame_) * x * curr_effector_);
+}
 
-        // Use the standard DH convention
-        if(this->convention() == "standard") {
-            z = this->get_z(q.q);
-        }
-        // Use the modified DH convention
-        else {
-            DQ w(0, 0, -sin(this->alpha()(i)), cos(this->alpha()(i)), 0, 0, -this->a()(i)*cos(this->alpha()(i)), -this->a()(i)*sin(this->alpha()(i)));
-            z =0.5 * q * w * q.conj();
-        }
-        if(this->dummy()(i) == 0.0) {
-            q = q * this->dh2dq(theta_vec(ith+1), i+1);
-            DQ aux_j = z * q_effector;
-            for(int k = 0; k < J.rows(); k++) {
-                J(k,ith+1) = aux_j.q(k);
-            }
-            ith = ith+1;
-        }
-        else
-            // Dummy joints don't contribute to the Jacobian
-            q = q * this->dh2dq(0.0,(i+1));
+/**
+* Returns the poses of all links, computed in a single sweep through the chain. Column i is vec8 of the pose of link
+* i+1 w.r.t. the reference frame, that is, reference_frame()*raw_fkm(theta_vec,i+1). The effector is not taken into
+* account. Use this instead of calling fkm(theta_vec,ith) once per link, which costs O(n^2) products.
+* \param Eigen::VectorXd theta_vec is the vector representing the theta joint angles.
+* \return A constant Eigen::MatrixXd (8,links).
+*/
+MatrixXd DQ_SerialManipulator::link_poses(const VectorXd& theta_vec) const
+{
+    MatrixXd poses(8, get_dim_configuration_space());
+    link_poses(theta_vec, poses);
+    return poses;
+}
+
+/**
+* Same as link_poses(theta_vec), but writes into memory supplied by the caller. Nothing is allocated.
+* \param Eigen::Ref<MatrixXd> link_poses must be 8xlinks and receives the poses.
+*/
+void DQ_SerialManipulator::link_poses(const VectorXd& theta_vec, Ref<MatrixXd> link_poses) const
+{
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::link_poses");
+    if(int(theta_vec.size()) != (this->get_dim_configuration_space() - this->n_dummy()) )
+    {
+        throw(std::range_error("Bad link_poses(theta_vec,link_poses) call: Incorrect number of joint variables"));
+    }
+    if(link_poses.rows() != 8 || link_poses.cols() != get_dim_configuration_space())
+    {
+        throw(std::range_error("Bad link_poses(theta_vec,link_poses) call: Incorrect size of link_poses"));
     }
 
-    return J;
+    DQ x;
+    dh_kernels::raw_fkm_and_joint_axes<double>(links_.data(), get_dim_configuration_space(), convention_, theta_vec, x.q.data(),
+                                               nullptr, 8, link_poses.data(), link_poses.outerStride());
+    for(int i = 0; i < link_poses.cols(); i++) {
+        link_poses.col(i) = (reference_frame_ * DQ(link_poses.col(i))).q;
+    }
+}
+
+/**
+* Returns, in a single sweep through the chain, the poses of all links, as link_poses(theta_vec), and the pose
+* Jacobians of all links. The Jacobians are stored one after the other in the contiguous, column-major
+* link_jacobians, so that they can be handed to a collision engine as a single buffer: columns
+* [i*(links - n_dummy), (i+1)*(links - n_dummy)) hold the Jacobian of the pose of link i+1. The columns of the joints
+* after link i+1 are zero. For every link but the last this is pose_jacobian(theta_vec,i+1) padded with zeros; for the
+* last link the effector is not taken into account, consistently with the returned pose.
+* Each column is vec8(reference_frame()*z_j*x_i), with the joint axes z_j and the raw link poses x_i obtained in
+* the sweep, so the cost is one product per non-zero column.
+* \param Eigen::VectorXd theta_vec is the vector representing the theta joint angles.
+* \param Eigen::Ref<MatrixXd> link_poses must be 8xlinks and receives the poses.
+* \param Eigen::Ref<MatrixXd> link_jacobians must be 8x(links*(links - n_dummy)) and receives the Jacobians.
+*/
+void DQ_SerialManipulator::link_poses_and_jacobians(const VectorXd& theta_vec, Ref<MatrixXd> link_poses, Ref<MatrixXd> link_jacobians) const
+{
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::link_poses_and_jacobians");
+    const int n_links  = get_dim_configuration_space();
+    const int n_joints = n_links - n_dummy();
+    if(link_poses.rows() != 8 || link_poses.cols() != n_links)
+    {
+        throw(std::range_error("Bad link_poses_and_jacobians(theta_vec,link_poses,link_jacobians) call: Incorrect size of link_poses"));
+    }
+    if(link_jacobians.rows() != 8 || link_jacobians.cols() != n_links*n_joints)
+    {
+        throw(std::range_error("Bad link_poses_and_jacobians(theta_vec,link_poses,link_jacobians) call: Incorrect size of link_jacobians"));
+    }
+    if(n_links == 0)
+        return;
+
+    // The Jacobian of the last link is written last, so its block holds the joint axes in the meantime
+    Ref<MatrixXd> axes = link_jacobians.rightCols(n_joints);
+    raw_fkm_and_joint_axes_(theta_vec, n_links, axes, &link_poses);
+    hamiplus8_product(reference_frame_, axes, axes);
+
+    for(int i = 0; i < n_links; i++) {
+        const DQ x_i(link_poses.col(i));
+        const int n_joints_i = n_joints_up_to_(i+1);
+        Ref<MatrixXd> J_i = link_jacobians.middleCols(i*n_joints, n_joints);
+        haminus8_product(x_i, axes.leftCols(n_joints_i), J_i.leftCols(n_joints_i));
+        J_i.rightCols(n_joints - n_joints_i).setZero();
+        link_poses.col(i) = (reference_frame_ * x_i).q;
+    }
 }
 
 /** Returns a MatrixXd 8x(links - n_dummy) representing the Jacobian of a robotic system DQ_SerialManipulator object.
@@ -450,66 +687,91 @@ MatrixXd DQ_SerialManipulator::raw_pose_jacobian(const VectorXd& theta_vec, cons
 */
 MatrixXd  DQ_SerialManipulator::pose_jacobian(const VectorXd& theta_vec, const int &to_link) const
 {
-    MatrixXd J = raw_pose_jacobian(theta_vec,to_link);
-    if(to_link==this->get_dim_configuration_space())
-    {
-        J = hamiplus8(reference_frame_)*haminus8(curr_effector_)*J;
-    }
-    else
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::pose_jacobian");
+    MatrixXd J(8, n_joints_up_to_(to_link));
+    pose_jacobian(theta_vec, to_link, J);
+    return J;
+}
+
+/**
+* Same as pose_jacobian(theta_vec,to_link), but writes into memory supplied by the caller. Nothing is allocated, so it
+* can be used in loops that must not call malloc.
+* \param Eigen::Ref<MatrixXd> pose_jacobian must be 8x(number of joints up to to_link) and receives the Jacobian.
+*/
+void DQ_SerialManipulator::pose_jacobian(const VectorXd& theta_vec, const int& to_link, Ref<MatrixXd> pose_jacobian) const
+{
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::pose_jacobian");
+    if(pose_jacobian.rows() != 8 || pose_jacobian.cols() != n_joints_up_to_(to_link))
     {
-        J = hamiplus8(reference_frame_)*J;
+        throw(std::range_error("Bad pose_jacobian(theta_vec,to_link,pose_jacobian) call: Incorrect size of pose_jacobian"));
     }
-    return J;
+    raw_fkm_and_pose_jacobian_(theta_vec, to_link, pose_jacobian, nullptr);
+    raw_to_pose_jacobian_(to_link, pose_jacobian);
+}
+
+/**
+* Per-sample kernel of batch_pose_jacobian(). Same as pose_jacobian(theta_vec,to_link), but pose_jacobian keeps its
+* memory from one sample to the next.
+*/
+void DQ_SerialManipulator::batch_pose_jacobian_kernel_(const VectorXd& theta_vec, const int& to_link, MatrixXd& pose_jacobian) const
+{
+    pose_jacobian.resize(8, n_joints_up_to_(to_link));
+    this->pose_jacobian(theta_vec, to_link, pose_jacobian);
 }
 
 MatrixXd DQ_SerialManipulator::pose_jacobian(const VectorXd &theta_vec) const
 {
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::pose_jacobian");
     return pose_jacobian(theta_vec,get_dim_configuration_space());
 }
 
 MatrixXd DQ_SerialManipulator::pose_jacobian_derivative(const VectorXd &theta_vec, const VectorXd &theta_vec_dot, const int &to_link) const
 {
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::pose_jacobian_derivative");
+    MatrixXd J_dot(8, n_joints_up_to_(to_link));
+    pose_jacobian_derivative(theta_vec, theta_vec_dot, to_link, J_dot);
+    return J_dot;
+}
 
-    int n = to_link;
-    DQ x_effector = raw_fkm(theta_vec,to_link);
-    MatrixXd J    = raw_pose_jacobian(theta_vec,to_link);
-    VectorXd vec_x_effector_dot = J*theta_vec_dot.head(to_link);
-
-    DQ x = DQ(1);
-    MatrixXd J_dot = MatrixXd::Zero(8,n-n_dummy());
-    int jth=0;
-
-    for(int i=0;i<n;i++)
+/**
+* Same as pose_jacobian_derivative(theta_vec,theta_vec_dot,to_link), but writes into memory supplied by the caller.
+* Nothing is allocated. As in the returning overload, the displacements due to the base and the effector are not
+* taken into account.
+* Column j of the raw Jacobian is vec8(z_j*x), where z_j is the axis of joint j and x the pose of link to_link. With
+* s_j = sum_{k<j} theta_dot_k*z_k and s the same sum over all joints, x_dot = s*x and z_j_dot = s_j*z_j + z_j*conj(s_j).
+* Column j of the derivative is therefore vec8((s_j*z_j + z_j*conj(s_j) + z_j*s)*x), which needs one sweep through the
+* chain instead of one per joint.
+* \param Eigen::VectorXd theta_vec_dot holds at least the velocities of the joints up to to_link, e.g. all the joint
+* velocities or only those up to to_link. Any further entries are ignored.
+* \param Eigen::Ref<MatrixXd> pose_jacobian_derivative must be 8x(number of joints up to to_link) and receives the
+* time derivative of the raw pose Jacobian.
+*/
+void DQ_SerialManipulator::pose_jacobian_derivative(const VectorXd &theta_vec, const VectorXd &theta_vec_dot, const int &to_link, Ref<MatrixXd> pose_jacobian_derivative) const
+{
+    DQROBOTICS_INSTRUMENT_CALL("DQ_SerialManipulator::pose_jacobian_derivative");
+    if(int(theta_vec_dot.size()) < n_joints_up_to_(to_link))
     {
-        DQ w;
-        DQ z;
-        // Use the standard DH convention
-        if(this->convention() == "standard") {
-            w = k_;
-            z = get_z(x.q);
-        }
-        else //Use the modified DH convention
-        {
-            w = DQ(0,0,-sin(alpha()(i)),cos(alpha()(i)),0,0,-a()(i)*cos(alpha()(i)),-a()(i)*sin(alpha()(i)));
-            z = 0.5*x*w*conj(x);
-        }
+        throw(std::range_error("Bad pose_jacobian_derivative(theta_vec,theta_vec_dot,to_link) call: Not enough joint velocities"));
+    }
+    if(pose_jacobian_derivative.rows() != 8 || pose_jacobian_derivative.cols() != n_joints_up_to_(to_link))
+    {
+        throw(std::range_error("Bad pose_jacobian_derivative(theta_vec,theta_vec_dot,to_link,pose_jacobian_derivative) call: Incorrect size of pose_jacobian_derivative"));
+    }
 
-        if( dummy()(i)!=1.0 )
-        {
-            VectorXd vec_zdot = 0.5*(haminus8(w*conj(x)) + hamiplus8(x*w)*C8())*raw_pose_jacobian(theta_vec,i)*theta_vec_dot.head(i);
+    Ref<MatrixXd>& J_dot = pose_jacobian_derivative;
+    const DQ x = raw_fkm_and_joint_axes_(theta_vec, to_link, J_dot, nullptr);
 
-            J_dot.col(jth) = haminus8(x_effector)*vec_zdot + hamiplus8(z)*vec_x_effector_dot;
-            x = x*dh2dq(theta_vec(jth),i+1);
-            jth = jth+1;
-        }
-        else
-        {
-            //Dummy joints don't contribute to the Jacobian
-            x = x*dh2dq(0,i);
-        }
+    DQ s(0);
+    for(int j = 0; j < J_dot.cols(); j++) {
+        s = lazy(s) + theta_vec_dot(j) * lazy(DQ(J_dot.col(j)));
     }
 
-    return J_dot;
+    DQ s_j(0);
+    for(int j = 0; j < J_dot.cols(); j++) {
+        const DQ z(J_dot.col(j));
+        J_dot.col(j) = eval((s_j * lazy(z) + z * conj(lazy(s_j)) + z * s) * x).q;
+        s_j = lazy(s_j) + theta_vec_dot(j) * lazy(z);
+    }
 }
 
 }//namespace DQ_robotics
@@ -47,16 +47,21 @@ DQ DQ_WholeBody::fkm(const VectorXd &q) const
     return fkm(q,chain_.size());
 }
 
-DQ DQ_WholeBody::fkm(const VectorXd &q, const int &to_chain) const
+UnitDQ DQ_WholeBody::unit_fkm(const VectorXd &q) const
 {
-    DQ pose(1);
+    return fkm(q,chain_.size());
+}
+
+UnitDQ DQ_WholeBody::fkm(const VectorXd &q, const int &to_chain) const
+{
+    UnitDQ pose;
 
     int q_counter = 0;
     for(int i=0;i<to_chain;i++)
     {
         const int current_robot_dim    = chain_[i]->get_dim_configuration_space();
         const VectorXd current_robot_q = q.segment(q_counter,current_robot_dim);
-        pose = pose * chain_[i]->fkm(current_robot_q);
+        pose = pose * chain_[i]->unit_fkm(current_robot_q);
         q_counter += current_robot_dim;
     }
 
@@ -66,20 +71,20 @@ DQ DQ_WholeBody::fkm(const VectorXd &q, const int &to_chain) const
 MatrixXd DQ_WholeBody::pose_jacobian(const VectorXd &q, const int &to_link) const
 {
     int n = chain_.size();
-    DQ x_0_to_n = fkm(q,n);
+    const UnitDQ x_0_to_n = fkm(q,n);
     int q_counter = 0;
 
     //Not a good implementation but similar to MATLAB
     std::vector<MatrixXd> J_vector;
     for(int i=0;i<n;i++)
     {
-        DQ x_0_to_iplus1 = fkm(q,i);
-        DQ x_iplus1_to_n = conj(x_0_to_iplus1)*x_0_to_n;
+        const UnitDQ x_0_to_iplus1 = fkm(q,i);
+        const UnitDQ x_iplus1_to_n = conj(x_0_to_iplus1)*x_0_to_n;
 
         int dim = chain_[i]->get_dim_configuration_space();
         VectorXd q_iplus1 = q.segment(q_counter,dim);
         q_counter += dim;
-        J_vector.push_back(hamiplus8(fkm(q,i))*haminus8(x_iplus1_to_n)*chain_[i]->pose_jacobian(q_iplus1,n));
+        J_vector.push_back(hamiplus8_product(x_0_to_iplus1,haminus8_product(x_iplus1_to_n,chain_[i]->pose_jacobian(q_iplus1,n))));
     }
 
     MatrixXd J_pose(8,q_counter);
@@ -0,0 +1,557 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/solvers/DQ_ActiveSetQuadraticProgrammingSolver.h>
+#include<algorithm>
+#include<cmath>
+#include<limits>
+#include<stdexcept>
+
+namespace DQ_robotics
+{
+
+static const double QP_EPSILON  = std::numeric_limits<double>::epsilon();
+static const double QP_INFINITY = std::numeric_limits<double>::infinity();
+
+/**
+* Creates a solver with hot start enabled and at most 1000 iterations per solve.
+*/
+DQ_ActiveSetQuadraticProgrammingSolver::DQ_ActiveSetQuadraticProgrammingSolver():
+    maximum_iterations_(1000),
+    hot_start_(true),
+    status_(Status::solved),
+    iterations_(0),
+    objective_value_(0.0),
+    n_active_(0),
+    r_norm_(1.0)
+{
+
+}
+
+/**
+* Sets the maximum number of iterations, each one adds or drops a constraint.
+*/
+void DQ_ActiveSetQuadraticProgrammingSolver::set_maximum_iterations(const int& maximum_iterations)
+{
+    if(maximum_iterations < 1)
+    {
+        throw std::range_error("Bad set_maximum_iterations(maximum_iterations) call: maximum_iterations must be positive");
+    }
+    maximum_iterations_ = maximum_iterations;
+}
+
+int DQ_ActiveSetQuadraticProgrammingSolver::maximum_iterations() const
+{
+    return maximum_iterations_;
+}
+
+/**
+* Enables or disables adding the constraints that were active in the previous solve first.
+*/
+void DQ_ActiveSetQuadraticProgrammingSolver::set_hot_start(const bool& hot_start)
+{
+    hot_start_ = hot_start;
+}
+
+bool DQ_ActiveSetQuadraticProgrammingSolver::hot_start() const
+{
+    return hot_start_;
+}
+
+void DQ_ActiveSetQuadraticProgrammingSolver::resize_(const int& n, const int& m, const int& p)
+{
+    //At most n constraints are active, one more slot is used while a constraint is being added
+    const int n_multipliers = std::max(n, m + p) + 1;
+
+    if(J_.rows() != n)
+    {
+        cholesky_ = LLT<MatrixXd>(n);
+        J_.resize(n, n);
+        R_.resize(n, n);
+        x_.resize(n);
+        x_old_.resize(n);
+        d_.resize(n);
+        z_.resize(n);
+        np_.resize(n);
+    }
+    if(u_.size() != n_multipliers)
+    {
+        r_.resize(n_multipliers);
+        u_.resize(n_multipliers);
+        u_old_.resize(n_multipliers);
+        active_.resize(n_multipliers);
+        active_old_.resize(n_multipliers);
+    }
+    if(slack_.size() != m)
+    {
+        slack_.resize(m);
+        inactive_.resize(m);
+        eligible_.resize(m);
+        previously_active_ = VectorXi::Zero(m);
+    }
+}
+
+/**
+* d = J^T*np, the primal direction z = J2*d2 in the null space of the active constraints, and the dual direction r,
+* the solution of R*r = d1, where J = [J1 J2] and d = [d1 d2] are split after the active constraints.
+*/
+void DQ_ActiveSetQuadraticProgrammingSolver::compute_step_directions_()
+{
+    const int n = J_.rows();
+    d_.noalias() = J_.transpose()*np_;
+    z_.noalias() = J_.rightCols(n - n_active_)*d_.tail(n - n_active_);
+
+    auto r = r_.head(n_active_);
+    r = d_.head(n_active_);
+    R_.topLeftCorner(n_active_, n_active_).triangularView<Upper>().solveInPlace(r);
+}
+
+/**
+* Adds the constraint whose direction d was computed last to the factorization, by rotating J so that d has a single
+* non-zero below the active constraints.
+* \return false if the constraint is linearly dependent on the active ones.
+*/
+bool DQ_ActiveSetQuadraticProgrammingSolver::add_constraint_()
+{
+    const int n = J_.rows();
+    for(int j = n - 1; j >= n_active_ + 1; j--)
+    {
+        double cc = d_(j - 1);
+        double ss = d_(j);
+        const double h = std::hypot(cc, ss);
+        if(h < QP_EPSILON)
+            continue;
+        d_(j) = 0.0;
+        ss = ss/h;
+        cc = cc/h;
+        if(cc < 0.0)
+        {
+            cc = -cc;
+            ss = -ss;
+            d_(j - 1) = -h;
+        }
+        else
+        {
+            d_(j - 1) = h;
+        }
+        const double xny = ss/(1.0 + cc);
+        for(int k = 0; k < n; k++)
+        {
+            const double t1 = J_(k, j - 1);
+            const double t2 = J_(k, j);
+            J_(k, j - 1) = t1*cc + t2*ss;
+            J_(k, j) = xny*(t1 + J_(k, j - 1)) - t2;
+        }
+    }
+
+    n_active_++;
+    R_.col(n_active_ - 1).head(n_active_) = d_.head(n_active_);
+
+    if(std::abs(d_(n_active_ - 1)) <= QP_EPSILON*r_norm_)
+        return false;
+    r_norm_ = std::max(r_norm_, std::abs(d_(n_active_ - 1)));
+    return true;
+}
+
+/**
+* Removes an active inequality constraint and restores the triangular structure of R with Givens rotations, which are
+* also applied to J.
+*/
+void DQ_ActiveSetQuadraticProgrammingSolver::delete_constraint_(const int& constraint, const int& n_equalities)
+{
+    const int n = J_.rows();
+
+    int qq = -1;
+    for(int i = n_equalities; i < n_active_; i++)
+    {
+        if(active_(i) == constraint)
+        {
+            qq = i;
+            break;
+        }
+    }
+
+    for(int i = qq; i < n_active_ - 1; i++)
+    {
+        active_(i) = active_(i + 1);
+        u_(i) = u_(i + 1);
+        R_.col(i) = R_.col(i + 1);
+    }
+    active_(n_active_ - 1) = active_(n_active_);
+    u_(n_active_ - 1) = u_(n_active_);
+    active_(n_active_) = 0;
+    u_(n_active_) = 0.0;
+    R_.col(n_active_ - 1).head(n_active_).setZero();
+    n_active_--;
+
+    if(n_active_ == 0)
+        return;
+
+    for(int j = qq; j < n_active_; j++)
+    {
+        double cc = R_(j, j);
+        double ss = R_(j + 1, j);
+        const double h = std::hypot(cc, ss);
+        if(h < QP_EPSILON)
+            continue;
+        cc = cc/h;
+        ss = ss/h;
+        R_(j + 1, j) = 0.0;
+        if(cc < 0.0)
+        {
+            R_(j, j) = -h;
+            cc = -cc;
+            ss = -ss;
+        }
+        else
+        {
+            R_(j, j) = h;
+        }
+        const double xny = ss/(1.0 + cc);
+        for(int k = j + 1; k < n_active_; k++)
+        {
+            const double t1 = R_(j, k);
+            const double t2 = R_(j + 1, k);
+            R_(j, k) = t1*cc + t2*ss;
+            R_(j + 1, k) = xny*(t1 + R_(j, k)) - t2;
+        }
+        for(int k = 0; k < n; k++)
+        {
+            const double t1 = J_(k, j);
+            const double t2 = J_(k, j + 1);
+            J_(k, j) = t1*cc + t2*ss;
+            J_(k, j + 1) = xny*(J_(k, j) + t1) - t2;
+        }
+    }
+}
+
+/**
+* The most violated inequality among those that can be added, looking first at the ones active in the previous solve
+* when hot start is enabled.
+* \return Its index, or -1 if none is violated.
+*/
+int DQ_ActiveSetQuadraticProgrammingSolver::select_violated_constraint_() const
+{
+    const int m = slack_.size();
+    double most_violated = 0.0;
+    int selected = -1;
+
+    if(hot_start_)
+    {
+        for(int i = 0; i < m; i++)
+        {
+            if(previously_active_(i) && slack_(i) < most_violated && inactive_(i) != -1 && eligible_(i))
+            {
+                most_violated = slack_(i);
+                selected = i;
+            }
+        }
+        if(selected >= 0)
+            return selected;
+    }
+
+    for(int i = 0; i < m; i++)
+    {
+        if(slack_(i) < most_violated && inactive_(i) != -1 && eligible_(i))
+        {
+            most_violated = slack_(i);
+            selected = i;
+        }
+    }
+    return selected;
+}
+
+DQ_ActiveSetQuadraticProgrammingSolver::Status DQ_ActiveSetQuadraticProgrammingSolver::finish_(const Status& status, const int& n_equalities)
+{
+    previously_active_.setZero();
+    for(int i = n_equalities; i < n_active_; i++)
+        previously_active_(active_(i)) = 1;
+    status_ = status;
+    return status_;
+}
+
+/**
+* Solves min_x 0.5*x^T*H*x + f^T*x subject to A*x <= b and Aeq*x = beq.
+* \param Eigen::MatrixXd H is the nxn symmetric positive definite Hessian.
+* \param Eigen::VectorXd f is the n-dimensional linear term.
+* \param Eigen::MatrixXd A is the mxn inequality matrix, it can have zero rows.
+* \param Eigen::VectorXd b is the m-dimensional inequality vector.
+* \param Eigen::MatrixXd Aeq is the pxn equality matrix, it can have zero rows. Its rows must be linearly independent,
+* so p <= n.
+* \param Eigen::VectorXd beq is the p-dimensional equality vector.
+* \return Status::solved, Status::infeasible, or Status::maximum_iterations. The solution is only optimal in the
+* first case.
+*/
+DQ_ActiveSetQuadraticProgrammingSolver::Status DQ_ActiveSetQuadraticProgrammingSolver::solve(const MatrixXd& H, const VectorXd& f,
+                                                                                              const MatrixXd& A, const VectorXd& b,
+                                                                                              const MatrixXd& Aeq, const VectorXd& beq)
+{
+    const int n = H.rows();
+    const int m = A.rows();
+    const int p = Aeq.rows();
+    if(H.cols() != n || f.size() != n)
+    {
+        throw std::range_error("Bad solve(H,f,A,b,Aeq,beq) call: H must be nxn and f must have n elements");
+    }
+    if(b.size() != m || (m > 0 && A.cols() != n))
+    {
+        throw std::range_error("Bad solve(H,f,A,b,Aeq,beq) call: A must be mxn and b must have m elements");
+    }
+    if(beq.size() != p || (p > 0 && Aeq.cols() != n))
+    {
+        throw std::range_error("Bad solve(H,f,A,b,Aeq,beq) call: Aeq must be pxn and beq must have p elements");
+    }
+    if(p > n)
+    {
+        //More rows than variables cannot be independent, and R and d only have room for n active constraints
+        throw std::range_error("Bad solve(H,f,A,b,Aeq,beq) call: the rows of Aeq must be linearly independent");
+    }
+
+    resize_(n, m, p);
+    iterations_ = 0;
+
+    //Unconstrained minimum, x = -H^-1*f
+    cholesky_.compute(H);
+    if(cholesky_.info() != Success)
+    {
+        throw std::range_error("Bad solve(H,f,A,b,Aeq,beq) call: H must be symmetric positive definite");
+    }
+    J_.setIdentity();
+    cholesky_.matrixU().solveInPlace(J_);
+    const double c1 = H.trace();
+    const double c2 = J_.trace();
+
+    x_ = f;
+    cholesky_.solveInPlace(x_);
+    x_ = -x_;
+    objective_value_ = 0.5*f.dot(x_);
+
+    n_active_ = 0;
+    r_norm_ = 1.0;
+    R_.setZero();
+    u_.setZero();
+
+    //Equality constraints are added first, with full steps
+    for(int i = 0; i < p; i++)
+    {
+        np_ = Aeq.row(i).transpose();
+        compute_step_directions_();
+
+        double t2 = 0.0;
+        if(z_.squaredNorm() > QP_EPSILON)
+            t2 = (beq(i) - np_.dot(x_))/z_.dot(np_);
+
+        x_ += t2*z_;
+        u_(n_active_) = t2;
+        u_.head(n_active_) -= t2*r_.head(n_active_);
+        objective_value_ += 0.5*t2*t2*z_.dot(np_);
+        active_(i) = -i - 1;
+
+        if(!add_constraint_())
+        {
+            throw std::range_error("Bad solve(H,f,A,b,Aeq,beq) call: the rows of Aeq must be linearly independent");
+        }
+    }
+
+    for(int i = 0; i < m; i++)
+        inactive_(i) = i;
+
+    while(true)
+    {
+        //Step 1: stop if no inequality is violated
+        if(++iterations_ > maximum_iterations_)
+            return finish_(Status::maximum_iterations, p);
+
+        for(int i = p; i < n_active_; i++)
+            inactive_(active_(i)) = -1;
+
+        double psi = 0.0;
+        for(int i = 0; i < m; i++)
+        {
+            eligible_(i) = 1;
+            slack_(i) = b(i) - A.row(i).dot(x_);
+            psi += std::min(0.0, slack_(i));
+        }
+        if(std::abs(psi) <= m*QP_EPSILON*c1*c2*100.0)
+            return finish_(Status::solved, p);
+
+        u_old_.head(n_active_) = u_.head(n_active_);
+        active_old_.head(n_active_) = active_.head(n_active_);
+        x_old_ = x_;
+
+        bool added = false;
+        while(!added)
+        {
+            //Step 2: choose a violated constraint
+            const int ip = select_violated_constraint_();
+            if(ip < 0)
+                return finish_(Status::solved, p);
+
+            np_ = -A.row(ip).transpose();
+            u_(n_active_) = 0.0;
+            active_(n_active_) = ip;
+
+            while(true)
+            {
+                if(++iterations_ > maximum_iterations_)
+                    return finish_(Status::maximum_iterations, p);
+
+                //Step 2a: step directions
+                compute_step_directions_();
+
+                //Step 2b: partial step length t1, limited by the multipliers, and full step length t2
+                int l = -1;
+                double t1 = QP_INFINITY;
+                for(int k = p; k < n_active_; k++)
+                {
+                    if(r_(k) > 0.0 && u_(k)/r_(k) < t1)
+                    {
+                        t1 = u_(k)/r_(k);
+                        l = active_(k);
+                    }
+                }
+                double t2 = QP_INFINITY;
+                if(z_.squaredNorm() > QP_EPSILON)
+                    t2 = -slack_(ip)/z_.dot(np_);
+                const double t = std::min(t1, t2);
+
+                //Step 2c: take the step
+                if(t >= QP_INFINITY)
+                    return finish_(Status::infeasible, p);
+
+                if(t2 >= QP_INFINITY)
+                {
+                    //Step in the dual space only, drop constraint l
+                    u_.head(n_active_) -= t*r_.head(n_active_);
+                    u_(n_active_) += t;
+                    inactive_(l) = l;
+                    delete_constraint_(l, p);
+                    continue;
+                }
+
+                x_ += t*z_;
+                objective_value_ += t*z_.dot(np_)*(0.5*t + u_(n_active_));
+                u_.head(n_active_) -= t*r_.head(n_active_);
+                u_(n_active_) += t;
+
+                if(std::abs(t - t2) < QP_EPSILON)
+                {
+                    //Full step, constraint ip becomes active
+                    if(!add_constraint_())
+                    {
+                        eligible_(ip) = 0;
+                        delete_constraint_(ip, p);
+                        for(int i = 0; i < m; i++)
+                            inactive_(i) = i;
+                        for(int i = p; i < n_active_; i++)
+                        {
+                            active_(i) = active_old_(i);
+                            u_(i) = u_old_(i);
+                            inactive_(active_(i)) = -1;
+                        }
+                        x_ = x_old_;
+                    }
+                    else
+                    {
+                        inactive_(ip) = -1;
+                        added = true;
+                    }
+                    break;
+                }
+
+                //Partial step, drop constraint l and try again to add ip
+                inactive_(l) = l;
+                delete_constraint_(l, p);
+                slack_(ip) = b(ip) - A.row(ip).dot(x_);
+            }
+        }
+    }
+}
+
+/**
+* Returns the status of the last solve.
+*/
+DQ_ActiveSetQuadraticProgrammingSolver::Status DQ_ActiveSetQuadraticProgrammingSolver::status() const
+{
+    return status_;
+}
+
+/**
+* Returns the solution of the last solve.
+*/
+const VectorXd& DQ_ActiveSetQuadraticProgrammingSolver::solution() const
+{
+    return x_;
+}
+
+/**
+* Returns 0.5*x^T*H*x + f^T*x at the solution of the last solve.
+*/
+double DQ_ActiveSetQuadraticProgrammingSolver::objective_value() const
+{
+    return objective_value_;
+}
+
+/**
+* Returns the number of iterations of the last solve.
+*/
+int DQ_ActiveSetQuadraticProgrammingSolver::iterations() const
+{
+    return iterations_;
+}
+
+/**
+* Returns the indexes of the rows of A that were active at the end of the last solve.
+*/
+VectorXi DQ_ActiveSetQuadraticProgrammingSolver::active_inequality_constraints() const
+{
+    VectorXi active(previously_active_.sum());
+    int j = 0;
+    for(int i = 0; i < previously_active_.size(); i++)
+    {
+        if(previously_active_(i))
+            active(j++) = i;
+    }
+    return active;
+}
+
+/**
+* Solves the quadratic program, see solve().
+* \exception std::runtime_error if the problem is infeasible or the maximum number of iterations is reached.
+*/
+VectorXd DQ_ActiveSetQuadraticProgrammingSolver::solve_quadratic_program(const MatrixXd& H, const VectorXd& f,
+                                                                         const MatrixXd& A, const VectorXd& b,
+                                                                         const MatrixXd& Aeq, const VectorXd& beq)
+{
+    const Status status = solve(H, f, A, b, Aeq, beq);
+    if(status == Status::infeasible)
+    {
+        throw std::runtime_error("Bad solve_quadratic_program(H,f,A,b,Aeq,beq) call: the problem is infeasible");
+    }
+    if(status == Status::maximum_iterations)
+    {
+        throw std::runtime_error("Bad solve_quadratic_program(H,f,A,b,Aeq,beq) call: maximum number of iterations reached");
+    }
+    return x_;
+}
+
+}
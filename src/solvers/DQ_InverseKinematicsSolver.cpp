@@ -0,0 +1,284 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/solvers/DQ_InverseKinematicsSolver.h>
+#include<dqrobotics/utils/DQ_Validation.h>
+#include<algorithm>
+#include<chrono>
+#include<cmath>
+#include<stdexcept>
+
+namespace DQ_robotics
+{
+
+//Levenberg-Marquardt damping update factors and the smallest damping it reaches
+static const double LM_DAMPING_DECREASE = 1.0/3.0;
+static const double LM_DAMPING_INCREASE = 2.0;
+static const double LM_MINIMUM_DAMPING  = 1e-9;
+
+/**
+* Creates a solver for @p robot with a tolerance of 1e-9 on the norm of the error, at most 100 iterations, and a
+* damping of 1e-3.
+* \param DQ_SerialManipulator robot is the robot whose inverse kinematics is solved. It must outlive the solver.
+* \param Method method is either Method::damped_least_squares or Method::levenberg_marquardt.
+* \param ErrorMetric error_metric is either ErrorMetric::pose or ErrorMetric::log.
+*/
+DQ_InverseKinematicsSolver::DQ_InverseKinematicsSolver(const DQ_SerialManipulator& robot,
+                                                       const Method& method,
+                                                       const ErrorMetric& error_metric):
+    robot_(&robot),
+    method_(method),
+    error_metric_(error_metric),
+    maximum_iterations_(100),
+    tolerance_(1e-9),
+    step_tolerance_(1e-12),
+    damping_(1e-3)
+{
+    result_.joint_configuration = VectorXd::Zero(robot.get_dim_configuration_space() - robot.n_dummy());
+    result_.converged  = false;
+    result_.iterations = 0;
+    result_.residual   = 0.0;
+    result_.time       = 0.0;
+}
+
+void DQ_InverseKinematicsSolver::set_method(const Method& method)
+{
+    method_ = method;
+}
+
+DQ_InverseKinematicsSolver::Method DQ_InverseKinematicsSolver::method() const
+{
+    return method_;
+}
+
+void DQ_InverseKinematicsSolver::set_error_metric(const ErrorMetric& error_metric)
+{
+    error_metric_ = error_metric;
+}
+
+DQ_InverseKinematicsSolver::ErrorMetric DQ_InverseKinematicsSolver::error_metric() const
+{
+    return error_metric_;
+}
+
+/**
+* Sets the maximum number of iterations of a solve.
+* \param int maximum_iterations must be positive.
+*/
+void DQ_InverseKinematicsSolver::set_maximum_iterations(const int& maximum_iterations)
+{
+    if(maximum_iterations < 1)
+    {
+        throw std::range_error("Bad set_maximum_iterations(maximum_iterations) call: maximum_iterations must be positive");
+    }
+    maximum_iterations_ = maximum_iterations;
+}
+
+int DQ_InverseKinematicsSolver::maximum_iterations() const
+{
+    return maximum_iterations_;
+}
+
+/**
+* Sets the norm of the error below which a solve is considered converged.
+* \param double tolerance must be positive.
+*/
+void DQ_InverseKinematicsSolver::set_tolerance(const double& tolerance)
+{
+    if(tolerance <= 0.0)
+    {
+        throw std::range_error("Bad set_tolerance(tolerance) call: tolerance must be positive");
+    }
+    tolerance_ = tolerance;
+}
+
+double DQ_InverseKinematicsSolver::tolerance() const
+{
+    return tolerance_;
+}
+
+/**
+* Sets the norm of the joint step below which a solve stops without converging, e.g. at a local minimum.
+* \param double step_tolerance must not be negative.
+*/
+void DQ_InverseKinematicsSolver::set_step_tolerance(const double& step_tolerance)
+{
+    if(step_tolerance < 0.0)
+    {
+        throw std::range_error("Bad set_step_tolerance(step_tolerance) call: step_tolerance must not be negative");
+    }
+    step_tolerance_ = step_tolerance;
+}
+
+double DQ_InverseKinematicsSolver::step_tolerance() const
+{
+    return step_tolerance_;
+}
+
+/**
+* Sets the damping. It is the fixed damping of Method::damped_least_squares and the initial damping of
+* Method::levenberg_marquardt.
+* \param double damping must be positive.
+*/
+void DQ_InverseKinematicsSolver::set_damping(const double& damping)
+{
+    if(damping <= 0.0)
+    {
+        throw std::range_error("Bad set_damping(damping) call: damping must be positive");
+    }
+    damping_ = damping;
+}
+
+double DQ_InverseKinematicsSolver::damping() const
+{
+    return damping_;
+}
+
+/**
+* Calculates the task error at @p q and its Jacobian.
+* \return The squared norm of the error.
+*/
+double DQ_InverseKinematicsSolver::evaluate_(const VectorXd& q, const DQ& desired_pose, MatrixXd& jacobian, Matrix<double,8,1>& error) const
+{
+    const DQ x = robot_->fkm_and_pose_jacobian(q, jacobian);
+
+    if(error_metric_ == ErrorMetric::pose)
+    {
+        if(x.q.dot(desired_pose.q) < 0.0)
+            error = x.q + desired_pose.q;
+        else
+            error = x.q - desired_pose.q;
+    }
+    else
+    {
+        //conj(xd)*x and -conj(xd)*x are the same pose, take the one closest to 1
+        DQ conj_desired_pose = conj(desired_pose);
+        DQ x_error = conj_desired_pose*x;
+        if(x_error.q(0) < 0.0)
+        {
+            conj_desired_pose = -conj_desired_pose;
+            x_error = -x_error;
+        }
+        error = log_unchecked(x_error).q;
+
+        //The real parts of the logarithm are always zero
+        hamiplus8_product(conj_desired_pose, jacobian, jacobian);
+        jacobian.row(0).setZero();
+        jacobian.row(4).setZero();
+    }
+    return error.squaredNorm();
+}
+
+/**
+* Solves the inverse kinematics of the robot for @p desired_pose starting from @p initial_configuration.
+* \param DQ desired_pose is the unit dual quaternion to be reached by the end effector.
+* \param Eigen::VectorXd initial_configuration is the initial guess of the joint configuration.
+* \return The result of the solve. The reference is valid until the next solve.
+*/
+const DQ_InverseKinematicsResult& DQ_InverseKinematicsSolver::solve(const DQ& desired_pose, const VectorXd& initial_configuration)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const int n = robot_->get_dim_configuration_space() - robot_->n_dummy();
+    if(int(initial_configuration.size()) != n)
+    {
+        throw std::range_error("Bad solve(desired_pose,initial_configuration) call: Incorrect number of joint variables");
+    }
+    if(DQROBOTICS_INPUT_VALIDATION && !is_unit(desired_pose))
+    {
+        throw std::range_error("Bad solve(desired_pose,initial_configuration) call: desired_pose is not a unit dual quaternion");
+    }
+
+    VectorXd& q = result_.joint_configuration;
+    q = initial_configuration;
+    q_trial_.resize(n);
+    step_.resize(n);
+
+    double squared_error = evaluate_(q, desired_pose, pose_jacobian_, error_);
+    const double squared_tolerance = tolerance_*tolerance_;
+    double lambda = damping_;
+    int iterations = 0;
+
+    while(squared_error >= squared_tolerance && iterations < maximum_iterations_)
+    {
+        iterations++;
+
+        //step = -J^T*(J*J^T + lambda*I)^-1*e, which equals -(J^T*J + lambda*I)^-1*J^T*e
+        damped_gram_.noalias() = pose_jacobian_*pose_jacobian_.transpose();
+        damped_gram_.diagonal().array() += lambda;
+        ldlt_.compute(damped_gram_);
+        y_ = ldlt_.solve(error_);
+        step_.noalias() = -pose_jacobian_.transpose()*y_;
+
+        if(step_.norm() < step_tolerance_)
+            break;
+
+        q_trial_ = q + step_;
+        const double squared_error_trial = evaluate_(q_trial_, desired_pose, pose_jacobian_trial_, error_trial_);
+
+        if(method_ == Method::damped_least_squares || squared_error_trial < squared_error)
+        {
+            q.swap(q_trial_);
+            pose_jacobian_.swap(pose_jacobian_trial_);
+            error_ = error_trial_;
+            squared_error = squared_error_trial;
+            if(method_ == Method::levenberg_marquardt)
+                lambda = std::max(lambda*LM_DAMPING_DECREASE, LM_MINIMUM_DAMPING);
+        }
+        else
+        {
+            lambda *= LM_DAMPING_INCREASE;
+        }
+    }
+
+    result_.converged  = squared_error < squared_tolerance;
+    result_.iterations = iterations;
+    result_.residual   = std::sqrt(squared_error);
+    result_.time       = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result_;
+}
+
+/**
+* Solves the inverse kinematics of the robot for @p desired_pose warm-starting from the previous solution, or from the
+* zero configuration before the first solve. Useful when tracking a sequence of nearby poses.
+* \param DQ desired_pose is the unit dual quaternion to be reached by the end effector.
+* \return The result of the solve. The reference is valid until the next solve.
+*/
+const DQ_InverseKinematicsResult& DQ_InverseKinematicsSolver::solve(const DQ& desired_pose)
+{
+    const int n = robot_->get_dim_configuration_space() - robot_->n_dummy();
+    if(int(result_.joint_configuration.size()) != n)
+    {
+        result_.joint_configuration = VectorXd::Zero(n);
+    }
+    return solve(desired_pose, result_.joint_configuration);
+}
+
+/**
+* Returns the result of the last solve.
+*/
+const DQ_InverseKinematicsResult& DQ_InverseKinematicsSolver::result() const
+{
+    return result_;
+}
+
+}
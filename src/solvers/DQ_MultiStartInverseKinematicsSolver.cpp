@@ -0,0 +1,202 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/solvers/DQ_MultiStartInverseKinematicsSolver.h>
+#include<dqrobotics/utils/DQ_Parallel.h>
+#include<algorithm>
+#include<chrono>
+#include<cmath>
+#include<stdexcept>
+
+namespace DQ_robotics
+{
+
+/**
+* Creates a multi-start solver that keeps every distinct solution, uses one thread per hardware thread, and considers
+* two solutions duplicates when no joint differs by more than 1e-3 rad.
+* \param DQ_InverseKinematicsSolver solver is copied and solves each seed, with all of its settings.
+*/
+DQ_MultiStartInverseKinematicsSolver::DQ_MultiStartInverseKinematicsSolver(const DQ_InverseKinematicsSolver& solver):
+    solver_(solver),
+    number_of_threads_(0),
+    maximum_solutions_(0),
+    duplicate_tolerance_(1e-3)
+{
+    result_.seeds_solved = 0;
+    result_.time         = 0.0;
+}
+
+/**
+* Replaces the solver that is copied to solve each seed.
+*/
+void DQ_MultiStartInverseKinematicsSolver::set_solver(const DQ_InverseKinematicsSolver& solver)
+{
+    solver_ = solver;
+    worker_solvers_.clear();
+}
+
+const DQ_InverseKinematicsSolver& DQ_MultiStartInverseKinematicsSolver::solver() const
+{
+    return solver_;
+}
+
+/**
+* Sets the number of threads, 0 or less means one per hardware thread. See parallel_for().
+*/
+void DQ_MultiStartInverseKinematicsSolver::set_number_of_threads(const int& number_of_threads)
+{
+    number_of_threads_ = number_of_threads;
+}
+
+int DQ_MultiStartInverseKinematicsSolver::number_of_threads() const
+{
+    return number_of_threads_;
+}
+
+/**
+* Sets the number of distinct solutions after which the search stops, 0 means that every seed is solved.
+*/
+void DQ_MultiStartInverseKinematicsSolver::set_maximum_solutions(const int& maximum_solutions)
+{
+    if(maximum_solutions < 0)
+    {
+        throw std::range_error("Bad set_maximum_solutions(maximum_solutions) call: maximum_solutions must not be negative");
+    }
+    maximum_solutions_ = maximum_solutions;
+}
+
+int DQ_MultiStartInverseKinematicsSolver::maximum_solutions() const
+{
+    return maximum_solutions_;
+}
+
+/**
+* Sets the largest joint difference, in rad, for which two solutions are considered the same.
+*/
+void DQ_MultiStartInverseKinematicsSolver::set_duplicate_tolerance(const double& duplicate_tolerance)
+{
+    if(duplicate_tolerance < 0.0)
+    {
+        throw std::range_error("Bad set_duplicate_tolerance(duplicate_tolerance) call: duplicate_tolerance must not be negative");
+    }
+    duplicate_tolerance_ = duplicate_tolerance;
+}
+
+double DQ_MultiStartInverseKinematicsSolver::duplicate_tolerance() const
+{
+    return duplicate_tolerance_;
+}
+
+bool DQ_MultiStartInverseKinematicsSolver::is_duplicate_(const Ref<const VectorXd>& a, const Ref<const VectorXd>& b) const
+{
+    for(int i = 0; i < a.size(); i++)
+    {
+        if(std::abs(std::remainder(a(i) - b(i), 2.0*M_PI)) > duplicate_tolerance_)
+            return false;
+    }
+    return true;
+}
+
+/**
+* Solves the inverse kinematics of the robot for @p desired_pose from each seed, in parallel.
+* Every converged solution is stored in the slot of its seed. The duplicates are then removed in seed order, after
+* parallel_for() returns, so the result does not depend on the number of threads or on the order in which the seeds
+* finish. With a maximum number of solutions, the seeds are solved in rounds of a few seeds per worker and the search
+* stops after the first round that completes that many distinct solutions.
+* \param DQ desired_pose is the unit dual quaternion to be reached by the end effector.
+* \param Eigen::MatrixXd seeds has one initial configuration per column.
+* \return The distinct solutions found. The reference is valid until the next solve.
+*/
+const DQ_MultiStartInverseKinematicsResult& DQ_MultiStartInverseKinematicsSolver::solve(const DQ& desired_pose, const MatrixXd& seeds)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const int n_seeds   = seeds.cols();
+    const int n_workers = parallel_number_of_workers(n_seeds, number_of_threads_);
+    if(int(worker_solvers_.size()) < n_workers)
+        worker_solvers_.resize(n_workers, solver_);
+    std::vector<VectorXd> seed_scratch(n_workers, VectorXd(seeds.rows()));
+
+    //Per-seed slots, each written only by the worker that solves that seed
+    MatrixXd          seed_solutions(seeds.rows(), n_seeds);
+    std::vector<char> seed_converged(n_seeds, 0);
+
+    std::vector<int> seed_indexes;
+    const int round_size = (maximum_solutions_ > 0) ? 4*n_workers : n_seeds;
+    int seeds_solved = 0;
+    while(seeds_solved < n_seeds)
+    {
+        const int round_begin = seeds_solved;
+        const int round_end   = std::min(n_seeds, round_begin + round_size);
+
+        parallel_for(round_end - round_begin, n_workers, [&](const int& task, const int& worker)
+        {
+            const int seed = round_begin + task;
+            VectorXd& initial_configuration = seed_scratch[worker];
+            initial_configuration = seeds.col(seed);
+            const DQ_InverseKinematicsResult& solve_result = worker_solvers_[worker].solve(desired_pose, initial_configuration);
+            if(solve_result.converged)
+            {
+                seed_solutions.col(seed) = solve_result.joint_configuration;
+                seed_converged[seed]     = 1;
+            }
+        });
+        seeds_solved = round_end;
+
+        //A seed is kept unless its solution duplicates the solution of a lower seed that was kept
+        for(int seed = round_begin; seed < round_end; seed++)
+        {
+            if(!seed_converged[seed])
+                continue;
+            if(maximum_solutions_ > 0 && int(seed_indexes.size()) >= maximum_solutions_)
+                break;
+            bool duplicate = false;
+            for(std::size_t i = 0; i < seed_indexes.size() && !duplicate; i++)
+                duplicate = is_duplicate_(seed_solutions.col(seed), seed_solutions.col(seed_indexes[i]));
+            if(!duplicate)
+                seed_indexes.push_back(seed);
+        }
+        if(maximum_solutions_ > 0 && int(seed_indexes.size()) >= maximum_solutions_)
+            break;
+    }
+
+    result_.solutions.resize(seeds.rows(), seed_indexes.size());
+    result_.seed_indexes.resize(seed_indexes.size());
+    for(std::size_t i = 0; i < seed_indexes.size(); i++)
+    {
+        result_.solutions.col(i) = seed_solutions.col(seed_indexes[i]);
+        result_.seed_indexes(i)  = seed_indexes[i];
+    }
+    result_.seeds_solved = seeds_solved;
+    result_.time         = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result_;
+}
+
+/**
+* Returns the result of the last solve.
+*/
+const DQ_MultiStartInverseKinematicsResult& DQ_MultiStartInverseKinematicsSolver::result() const
+{
+    return result_;
+}
+
+}
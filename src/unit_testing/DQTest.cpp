@@ -9,6 +9,7 @@ Unit tests for both DQ.cpp and DQ_kinematics.cpp
 
 
 #include "DQTest.h"
+#include <dqrobotics/robots/KukaLw4Robot.h>
 
 CPPUNIT_TEST_SUITE_REGISTRATION (DQTest);
 
@@ -66,21 +67,90 @@ void DQTest::displayTest(void)
 
 void DQTest::expTest(void)
 {
-    DQ dq1 = exp(2*log(i_));
+    DQ dq1 = exp(2.0*log(i_));
     DQ dq2 = DQ(-1);
 
     CPPUNIT_ASSERT(dq1==dq2);
 
-    dq1 = exp(2*log(j_));
+    dq1 = exp(2.0*log(j_));
 
     CPPUNIT_ASSERT(dq1==dq2);
 
-    dq1 = exp(2*log(k_));
+    dq1 = exp(2.0*log(k_));
 
     CPPUNIT_ASSERT(dq1==dq2);
 }
 
 
+/**
+* A unit dual quaternion with a random rotation of angle phi and a random translation.
+*/
+static DQ random_pose(const double& phi)
+{
+    const Vector3d n = Vector3d::Random().normalized();
+    const DQ r = cos(phi/2) + sin(phi/2)*(n(0)*i_ + n(1)*j_ + n(2)*k_);
+    const Vector3d t = Vector3d::Random();
+    return r + 0.5*E_*(t(0)*i_ + t(1)*j_ + t(2)*k_)*r;
+}
+
+static double distance(const DQ& dq1, const DQ& dq2)
+{
+    return (vec8(dq1) - vec8(dq2)).norm();
+}
+
+void DQTest::logExpClosedFormTest(void)
+{
+    //Angles near the identity use the series expansions, angles near 2*pi used to lose accuracy
+    const double angles[] = {0.0, 1e-12, 1e-9, 1e-6, 1e-3, 0.5, 1.0, 2.0, M_PI, 4.0, 6.0, 2*M_PI - 1e-7};
+    for(const double& phi : angles)
+    {
+        for(int trial = 0; trial < 10; trial++)
+        {
+            const DQ x = random_pose(phi);
+            const DQ l = log(x);
+
+            CPPUNIT_ASSERT( distance(exp(l), x) < 1e-14 );
+            CPPUNIT_ASSERT( distance(log_unchecked(x), l) == 0.0 );
+            CPPUNIT_ASSERT( distance(exp_unchecked(l), exp(l)) == 0.0 );
+
+            //Definition: log(x) = 0.5*phi*n + E*0.5*t
+            CPPUNIT_ASSERT( distance(D(l), 0.5*translation(x)) < 1e-14 );
+            //rotation_axis() is ill-conditioned near the identity and near 2*pi, where sin(phi/2) vanishes
+            if(phi > 1e-3 && phi < 2*M_PI - 1e-3)
+            {
+                CPPUNIT_ASSERT( distance(P(l), 0.5*rotation_angle(x)*rotation_axis(x)) < 1e-12 );
+            }
+        }
+    }
+
+    //Only unit dual quaternions have a logarithm, only pure ones an exponential
+    CPPUNIT_ASSERT_THROW( log(2.0*random_pose(1.0)), std::range_error );
+    CPPUNIT_ASSERT_THROW( exp(DQ(1,1,0,0,0,0,0,0)), std::range_error );
+}
+
+void DQTest::powTest(void)
+{
+    for(int trial = 0; trial < 20; trial++)
+    {
+        const DQ x = random_pose(0.3*trial);
+        const DQ r = P(x);
+
+        //pow(x,a) = exp(a*log(x)) rotates by a times the angle and translates by a times the translation
+        CPPUNIT_ASSERT( distance(pow(x,0.0), DQ(1)) < 1e-14 );
+        CPPUNIT_ASSERT( distance(pow(x,1.0), x) < 1e-14 );
+        CPPUNIT_ASSERT( distance(pow(x,0.3), exp(0.3*log(x))) < 1e-14 );
+        CPPUNIT_ASSERT( distance(translation(pow(x,0.3)), 0.3*translation(x)) < 1e-14 );
+        CPPUNIT_ASSERT( distance(pow_unchecked(x,0.3), pow(x,0.3)) == 0.0 );
+
+        //Without translation it is the power of the rotation
+        CPPUNIT_ASSERT( distance(pow(r,2.0), r*r) < 1e-14 );
+        CPPUNIT_ASSERT( distance(pow(r,-1.0), conj(r)) < 1e-14 );
+        CPPUNIT_ASSERT( distance(pow(r,0.5)*pow(r,0.5), r) < 1e-14 );
+    }
+
+    CPPUNIT_ASSERT_THROW( pow(2.0*random_pose(1.0),0.5), std::range_error );
+}
+
 void DQTest::sumTest(void)
 {
 	DQ dq1 = DQ(1.,2.,3.,4.,5.,6.,7.,8.);
@@ -129,7 +199,7 @@ void DQTest::Hplus4Test(void)
 
 	DQ dq1 = DQ(1.,2.,3.,4.,5.,6.,7.,8.);
 
-	Matrix4d hplus_test = dq1.Hplus4();
+	Matrix4d hplus_test = hamiplus4(dq1);
 
 	CPPUNIT_ASSERT( hplus_test == hplus);
 }
@@ -146,7 +216,7 @@ void DQTest::Hminus4Test(void)
 
 	DQ dq1 = DQ(1.,2.,3.,4.,5.,6.,7.,8.);
 
-	Matrix4d hminus_test = dq1.Hminus4();
+	Matrix4d hminus_test = haminus4(dq1);
 
 	CPPUNIT_ASSERT( hminus_test == hminus);
 }
@@ -157,8 +227,18 @@ void DQTest::H8Test(void)
 
 	DQ dq1 = DQ(1.,2.,3.,4.,5.,6.,7.,8.);
 
-	CPPUNIT_ASSERT( Hminus8(dq1) == haminus8(dq1));
-    CPPUNIT_ASSERT( Hplus8(dq1) == hamiplus8(dq1));
+	//The 8x8 matrices are built from the 4x4 matrices of the primary and dual parts
+	Matrix<double,8,8> hplus8 = Matrix<double,8,8>::Zero();
+	hplus8.topLeftCorner<4,4>()     = hamiplus4(P(dq1));
+	hplus8.bottomLeftCorner<4,4>()  = hamiplus4(D(dq1));
+	hplus8.bottomRightCorner<4,4>() = hamiplus4(P(dq1));
+	Matrix<double,8,8> hminus8 = Matrix<double,8,8>::Zero();
+	hminus8.topLeftCorner<4,4>()     = haminus4(P(dq1));
+	hminus8.bottomLeftCorner<4,4>()  = haminus4(D(dq1));
+	hminus8.bottomRightCorner<4,4>() = haminus4(P(dq1));
+
+	CPPUNIT_ASSERT( hminus8 == haminus8(dq1));
+    CPPUNIT_ASSERT( hplus8 == hamiplus8(dq1));
 }
 
 void DQTest::normalizeTest(void)
@@ -234,4 +314,35 @@ void DQTest::kinematicsTest(void)
 	
 }
 
+/*************************************************************/
+/********   POSE JACOBIAN DERIVATIVE TESTING   ***************/
+/*************************************************************/
 
+void DQTest::poseJacobianDerivativeTest(void)
+{
+    DQ_SerialManipulator kuka = KukaLw4Robot::kinematics();
+    kuka.set_reference_frame(normalize(1 + 0.2*i_) + 0.5*E_*(0.1*j_)*normalize(1 + 0.2*i_));
+    kuka.set_effector(normalize(1 + 0.3*k_) + 0.5*E_*(0.2*k_)*normalize(1 + 0.3*k_));
+
+    const double h = 1e-6;
+    for(int trial = 0; trial < 10; trial++)
+    {
+        const VectorXd thetas     = VectorXd::Random(7);
+        const VectorXd thetas_dot = VectorXd::Random(7);
+
+        MatrixXd J;
+        MatrixXd J_dot;
+        const DQ x = kuka.fkm_pose_jacobian_and_derivative(thetas,thetas_dot,J,J_dot);
+
+        CPPUNIT_ASSERT( (vec8(x) - vec8(kuka.fkm(thetas))).norm() < 1e-12 );
+        CPPUNIT_ASSERT( (J - kuka.pose_jacobian(thetas)).norm() < 1e-12 );
+
+        //Central differences of the pose Jacobian along the joint velocities
+        const MatrixXd J_dot_fd = (kuka.pose_jacobian(thetas + h*thetas_dot) - kuka.pose_jacobian(thetas - h*thetas_dot))/(2*h);
+        CPPUNIT_ASSERT( (J_dot - J_dot_fd).norm() < 1e-7 );
+
+        //pose_jacobian_derivative() is the derivative of the raw pose Jacobian
+        const MatrixXd raw_J_dot_fd = (kuka.raw_pose_jacobian(thetas + h*thetas_dot, 7) - kuka.raw_pose_jacobian(thetas - h*thetas_dot, 7))/(2*h);
+        CPPUNIT_ASSERT( (kuka.pose_jacobian_derivative(thetas,thetas_dot,7) - raw_J_dot_fd).norm() < 1e-7 );
+    }
+}
@@ -12,12 +12,9 @@ Unit tests header file for testing both DQ.cpp and DQ_kinematics.cpp
 
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
-#include <Eigen/Dense>
-#include "../DQ.h"
-#include "../DQ_kinematics.h"
-#include "../controllers/HInfinityRobustController.h"
-#include "../controllers/DampedNumericalFilteredController.h"
-#include "../controllers/TranslationFirstPoseController.h"
+#include <eigen3/Eigen/Dense>
+#include <dqrobotics/DQ.h>
+#include <dqrobotics/legacy/DQ_kinematics.h>
 #include <iostream>
 
 using namespace Eigen;
@@ -30,6 +27,8 @@ class DQTest : public CppUnit::TestFixture
     CPPUNIT_TEST (constructorTest);
     CPPUNIT_TEST (displayTest);
     CPPUNIT_TEST (expTest);
+    CPPUNIT_TEST (logExpClosedFormTest);
+    CPPUNIT_TEST (powTest);
 	CPPUNIT_TEST (sumTest);
 	CPPUNIT_TEST (subtractTest);
     CPPUNIT_TEST (copyTest);
@@ -38,6 +37,7 @@ class DQTest : public CppUnit::TestFixture
     CPPUNIT_TEST (H8Test);
     CPPUNIT_TEST (normalizeTest);
 	CPPUNIT_TEST (kinematicsTest);
+    CPPUNIT_TEST (poseJacobianDerivativeTest);
 	CPPUNIT_TEST_SUITE_END ();
 
 
@@ -54,6 +54,8 @@ protected:
   void displayTest();
 
   void expTest();
+  void logExpClosedFormTest();
+  void powTest();
   void sumTest();
   void subtractTest();
   void copyTest();
@@ -64,6 +66,7 @@ protected:
 
 
   void kinematicsTest();
+  void poseJacobianDerivativeTest();
 
 
 
@@ -0,0 +1,151 @@
+/**
+Unit tests for GenericDQ<double>, DQ_GenericSerialManipulator<double>, and DQ_FixedSerialManipulator, against DQ
+and DQ_SerialManipulator.
+
+*/
+
+#include "GenericDQTest.h"
+#include <dqrobotics/robot_modeling/DQ_FixedSerialManipulator.h>
+#include <dqrobotics/robot_modeling/DQ_GenericSerialManipulator.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (GenericDQTest);
+
+void GenericDQTest::setUp(void)
+{
+
+}
+
+void GenericDQTest::tearDown(void)
+{
+
+}
+
+static DQ random_pose()
+{
+    const DQ r = normalize(DQ(Vector4d::Random()));
+    const Vector3d t = Vector3d::Random();
+    return r + 0.5*E_*(t(0)*i_ + t(1)*j_ + t(2)*k_)*r;
+}
+
+static bool is_equal(const DQ& dq1, const DQ& dq2, const double& tolerance)
+{
+    return (vec8(dq1) - vec8(dq2)).norm() < tolerance;
+}
+
+/*************************************************************/
+/********   OPERATIONS                         ***************/
+/*************************************************************/
+
+void GenericDQTest::operationsTest(void)
+{
+    typedef GenericDQ<double> GDQ;
+
+    for(int trial = 0; trial < 100; trial++)
+    {
+        const DQ a = DQ(VectorXd::Random(8));
+        const DQ b = DQ(VectorXd::Random(8));
+        const DQ x = random_pose();
+        const GDQ ga(a), gb(b), gx(x);
+
+        CPPUNIT_ASSERT( is_equal((ga + gb).to_dq(), a + b, 1e-14) );
+        CPPUNIT_ASSERT( is_equal((ga - gb).to_dq(), a - b, 1e-14) );
+        CPPUNIT_ASSERT( is_equal((ga*gb).to_dq(), a*b, 1e-14) );
+        CPPUNIT_ASSERT( is_equal((0.5*ga).to_dq(), 0.5*a, 1e-14) );
+        CPPUNIT_ASSERT( is_equal(ga.P().to_dq(), P(a), 1e-14) );
+        CPPUNIT_ASSERT( is_equal(ga.D().to_dq(), D(a), 1e-14) );
+        CPPUNIT_ASSERT( is_equal(ga.Re().to_dq(), Re(a), 1e-14) );
+        CPPUNIT_ASSERT( is_equal(ga.Im().to_dq(), Im(a), 1e-14) );
+        CPPUNIT_ASSERT( is_equal(conj(ga).to_dq(), conj(a), 1e-14) );
+        CPPUNIT_ASSERT( is_equal(norm(ga).to_dq(), norm(a), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(inv(ga).to_dq(), inv(a), 1e-10) );
+        CPPUNIT_ASSERT( is_equal(normalize(ga).to_dq(), normalize(a), 1e-12) );
+        CPPUNIT_ASSERT( (ga.hamiplus8() - hamiplus8(a)).norm() < 1e-14 );
+        CPPUNIT_ASSERT( (ga.haminus8() - haminus8(a)).norm() < 1e-14 );
+        CPPUNIT_ASSERT( (ga.vec8() - vec8(a)).norm() < 1e-14 );
+        CPPUNIT_ASSERT( (ga.vec4() - vec4(a)).norm() < 1e-14 );
+
+        CPPUNIT_ASSERT( is_equal(translation(gx).to_dq(), translation(x), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(rotation(gx).to_dq(), rotation(x), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(log(gx).to_dq(), log(x), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(exp(log(gx)).to_dq(), exp(log(x)), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(pow(gx,0.3).to_dq(), pow(x,0.3), 1e-12) );
+    }
+}
+
+/*************************************************************/
+/********   EQUALITY                           ***************/
+/*************************************************************/
+
+void GenericDQTest::equalityTest(void)
+{
+    const DQ a = DQ(VectorXd::Random(8));
+    const DQ differences[] = {DQ(0), 1e-13*i_, 0.5e-12*E_*k_, 1e-11*j_, 1e-6*E_, DQ(1)};
+
+    //GenericDQ<double> must agree with the DQ_threshold tolerance of DQ's operator==
+    for(const DQ& difference : differences)
+    {
+        const DQ b = a + difference;
+        const bool dq_equal = (a == b);
+        CPPUNIT_ASSERT( (GenericDQ<double>(a) == GenericDQ<double>(b)) == dq_equal );
+        CPPUNIT_ASSERT( (GenericDQ<double>(a) != GenericDQ<double>(b)) != dq_equal );
+    }
+    CPPUNIT_ASSERT( GenericDQ<double>(a) == GenericDQ<double>(a + 1e-13*i_) );
+    CPPUNIT_ASSERT( GenericDQ<double>(a) != GenericDQ<double>(a + 1e-11*i_) );
+}
+
+/*************************************************************/
+/********   SERIAL MANIPULATORS                ***************/
+/*************************************************************/
+
+/**
+* The generic, fixed-size, and dynamic serial manipulators must agree on the poses and on the pose Jacobians.
+*/
+template<DQ_DHConvention CONVENTION, int LINKS>
+static void check_serial_manipulators(const DQ_SerialManipulator& robot)
+{
+    const int n = robot.get_dim_configuration_space() - robot.n_dummy();
+    const DQ_FixedSerialManipulator<7,CONVENTION,LINKS> fixed_robot(robot);
+    const DQ_GenericSerialManipulator<double> generic_robot(robot);
+
+    for(int trial = 0; trial < 20; trial++)
+    {
+        const VectorXd q = M_PI*VectorXd::Random(n);
+        const DQ x = robot.fkm(q);
+        const MatrixXd J = robot.pose_jacobian(q);
+
+        CPPUNIT_ASSERT( is_equal(generic_robot.fkm(q).to_dq(), x, 1e-12) );
+        CPPUNIT_ASSERT( is_equal(fixed_robot.fkm(q), x, 1e-12) );
+        CPPUNIT_ASSERT( (generic_robot.pose_jacobian(q) - J).norm() < 1e-12 );
+        CPPUNIT_ASSERT( (fixed_robot.pose_jacobian(typename DQ_FixedSerialManipulator<7,CONVENTION,LINKS>::JointVector(q)) - J).norm() < 1e-12 );
+        CPPUNIT_ASSERT( is_equal(fixed_robot.raw_fkm(q), robot.raw_fkm(q), 1e-12) );
+        CPPUNIT_ASSERT( (fixed_robot.raw_pose_jacobian(q) - robot.raw_pose_jacobian(q, LINKS)).norm() < 1e-12 );
+
+        for(int to_link = 0; to_link <= LINKS; to_link++)
+        {
+            CPPUNIT_ASSERT( is_equal(generic_robot.fkm(q,to_link).to_dq(), robot.fkm(q,to_link), 1e-12) );
+            CPPUNIT_ASSERT( is_equal(fixed_robot.fkm(q,to_link), robot.fkm(q,to_link), 1e-12) );
+            CPPUNIT_ASSERT( (fixed_robot.pose_jacobian(q,to_link) - robot.pose_jacobian(q,to_link)).norm() < 1e-12 );
+        }
+    }
+
+    const MatrixXd Q = M_PI*MatrixXd::Random(n,100);
+    CPPUNIT_ASSERT( (generic_robot.batch_fkm(Q) - robot.batch_fkm(Q)).norm() < 1e-11 );
+}
+
+void GenericDQTest::serialManipulatorTest(void)
+{
+    DQ_SerialManipulator kuka = KukaLw4Robot::kinematics();
+    kuka.set_reference_frame(random_pose());
+    kuka.set_effector(random_pose());
+    check_serial_manipulators<DQ_DHConvention::standard,7>(kuka);
+
+    //The modified convention, with a dummy joint
+    MatrixXd dh_matrix(5,8);
+    dh_matrix.topRows(4) = MatrixXd::Random(4,8);
+    dh_matrix.row(4) << 0, 0, 0, 1, 0, 0, 0, 0;
+    DQ_SerialManipulator robot(dh_matrix, "modified");
+    robot.set_reference_frame(random_pose());
+    robot.set_effector(random_pose());
+    check_serial_manipulators<DQ_DHConvention::modified,8>(robot);
+}
@@ -0,0 +1,37 @@
+/**
+Unit tests header file for testing GenericDQ<double>, DQ_GenericSerialManipulator<double>, and
+DQ_FixedSerialManipulator against DQ and DQ_SerialManipulator.
+
+*/
+
+
+#ifndef GENERICDQTEST_H
+#define GENERICDQTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <dqrobotics/GenericDQ.h>
+
+using namespace Eigen;
+using namespace DQ_robotics;
+
+class GenericDQTest : public CppUnit::TestFixture
+{
+
+    CPPUNIT_TEST_SUITE (GenericDQTest);
+    CPPUNIT_TEST (operationsTest);
+    CPPUNIT_TEST (equalityTest);
+    CPPUNIT_TEST (serialManipulatorTest);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void operationsTest();
+    void equalityTest();
+    void serialManipulatorTest();
+};
+
+#endif
@@ -0,0 +1,138 @@
+/**
+Unit tests for DQ_InverseKinematicsSolver.
+
+*/
+
+#include "InverseKinematicsSolverTest.h"
+#include <dqrobotics/robots/ComauSmartSixRobot.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (InverseKinematicsSolverTest);
+
+void InverseKinematicsSolverTest::setUp(void)
+{
+
+}
+
+void InverseKinematicsSolverTest::tearDown(void)
+{
+
+}
+
+/**
+* Distance between two poses, x and -x being the same pose.
+*/
+static double pose_distance(const DQ& x1, const DQ& x2)
+{
+    return std::min((vec8(x1) - vec8(x2)).norm(), (vec8(x1) + vec8(x2)).norm());
+}
+
+/*************************************************************/
+/********   CONVERGENCE TESTING                ***************/
+/*************************************************************/
+
+void InverseKinematicsSolverTest::convergenceTest(void)
+{
+    const DQ_SerialManipulator robots[] = {KukaLw4Robot::kinematics(), ComauSmartSixRobot::kinematics()};
+    const DQ_InverseKinematicsSolver::Method methods[] = {DQ_InverseKinematicsSolver::Method::damped_least_squares,
+                                                          DQ_InverseKinematicsSolver::Method::levenberg_marquardt};
+    const DQ_InverseKinematicsSolver::ErrorMetric metrics[] = {DQ_InverseKinematicsSolver::ErrorMetric::pose,
+                                                               DQ_InverseKinematicsSolver::ErrorMetric::log};
+
+    for(const DQ_SerialManipulator& robot : robots)
+    {
+        const int n = robot.get_dim_configuration_space() - robot.n_dummy();
+        for(const auto& method : methods)
+        {
+            for(const auto& metric : metrics)
+            {
+                DQ_InverseKinematicsSolver solver(robot, method, metric);
+                //A fixed damping slows the convergence along small singular values, keep it small
+                if(method == DQ_InverseKinematicsSolver::Method::damped_least_squares)
+                    solver.set_damping(1e-6);
+
+                int n_converged = 0;
+                for(int trial = 0; trial < 20; trial++)
+                {
+                    //Reachable poses, from initial guesses near the configurations that reach them
+                    const VectorXd q_desired = VectorXd::Random(n);
+                    const DQ x_desired = robot.fkm(q_desired);
+                    const VectorXd q_initial = q_desired + 0.1*VectorXd::Random(n);
+
+                    const DQ_InverseKinematicsResult& result = solver.solve(x_desired, q_initial);
+                    CPPUNIT_ASSERT( result.iterations <= solver.maximum_iterations() );
+                    if(result.converged)
+                    {
+                        n_converged++;
+                        CPPUNIT_ASSERT( result.residual < solver.tolerance() );
+                        CPPUNIT_ASSERT( pose_distance(robot.fkm(result.joint_configuration), x_desired) < 1e-6 );
+                    }
+                }
+
+                //Damped least squares takes every step, so it can stall where Levenberg-Marquardt does not
+                if(method == DQ_InverseKinematicsSolver::Method::levenberg_marquardt)
+                    CPPUNIT_ASSERT( n_converged == 20 );
+                else
+                    CPPUNIT_ASSERT( n_converged >= 18 );
+            }
+        }
+    }
+}
+
+void InverseKinematicsSolverTest::levenbergMarquardtDescentTest(void)
+{
+    DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+    DQ_InverseKinematicsSolver solver(robot, DQ_InverseKinematicsSolver::Method::levenberg_marquardt);
+
+    //Levenberg-Marquardt only takes steps that decrease the error, even when it does not converge
+    for(int trial = 0; trial < 20; trial++)
+    {
+        const DQ x_desired = robot.fkm(M_PI*VectorXd::Random(7));
+        const VectorXd q_initial = M_PI*VectorXd::Random(7);
+        const double initial_error = std::min((vec8(robot.fkm(q_initial)) - vec8(x_desired)).norm(),
+                                              (vec8(robot.fkm(q_initial)) + vec8(x_desired)).norm());
+
+        for(int maximum_iterations = 1; maximum_iterations <= 16; maximum_iterations *= 2)
+        {
+            solver.set_maximum_iterations(maximum_iterations);
+            const DQ_InverseKinematicsResult& result = solver.solve(x_desired, q_initial);
+            CPPUNIT_ASSERT( result.residual <= initial_error );
+            CPPUNIT_ASSERT( std::abs(result.residual - pose_distance(robot.fkm(result.joint_configuration), x_desired)) < 1e-12 );
+        }
+    }
+}
+
+void InverseKinematicsSolverTest::warmStartTest(void)
+{
+    DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+    DQ_InverseKinematicsSolver solver(robot);
+
+    //Tracking a slowly moving pose, every solve starts from the previous solution
+    VectorXd q = VectorXd::Random(7);
+    const VectorXd q_dot = VectorXd::Random(7);
+    solver.solve(robot.fkm(q), q);
+    for(int step = 0; step < 50; step++)
+    {
+        q += 0.01*q_dot;
+        const DQ x_desired = robot.fkm(q);
+        const DQ_InverseKinematicsResult& result = solver.solve(x_desired);
+        CPPUNIT_ASSERT( result.converged );
+        CPPUNIT_ASSERT( pose_distance(robot.fkm(result.joint_configuration), x_desired) < 1e-6 );
+    }
+
+    //A solve from the solution itself takes no iterations
+    const VectorXd q_solution = solver.result().joint_configuration;
+    CPPUNIT_ASSERT( solver.solve(robot.fkm(q_solution), q_solution).iterations == 0 );
+}
+
+void InverseKinematicsSolverTest::badInputTest(void)
+{
+    DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+    DQ_InverseKinematicsSolver solver(robot);
+
+    CPPUNIT_ASSERT_THROW( solver.solve(robot.fkm(VectorXd::Zero(7)), VectorXd::Zero(6)), std::range_error );
+    CPPUNIT_ASSERT_THROW( solver.solve(2.0*robot.fkm(VectorXd::Zero(7)), VectorXd::Zero(7)), std::range_error );
+    CPPUNIT_ASSERT_THROW( solver.set_tolerance(0.0), std::range_error );
+    CPPUNIT_ASSERT_THROW( solver.set_damping(-1.0), std::range_error );
+    CPPUNIT_ASSERT_THROW( solver.set_maximum_iterations(0), std::range_error );
+}
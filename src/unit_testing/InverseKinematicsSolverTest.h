@@ -0,0 +1,38 @@
+/**
+Unit tests header file for testing DQ_InverseKinematicsSolver.
+
+*/
+
+
+#ifndef INVERSEKINEMATICSSOLVERTEST_H
+#define INVERSEKINEMATICSSOLVERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <dqrobotics/solvers/DQ_InverseKinematicsSolver.h>
+
+using namespace Eigen;
+using namespace DQ_robotics;
+
+class InverseKinematicsSolverTest : public CppUnit::TestFixture
+{
+
+    CPPUNIT_TEST_SUITE (InverseKinematicsSolverTest);
+    CPPUNIT_TEST (convergenceTest);
+    CPPUNIT_TEST (levenbergMarquardtDescentTest);
+    CPPUNIT_TEST (warmStartTest);
+    CPPUNIT_TEST (badInputTest);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void convergenceTest();
+    void levenbergMarquardtDescentTest();
+    void warmStartTest();
+    void badInputTest();
+};
+
+#endif
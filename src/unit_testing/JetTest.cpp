@@ -0,0 +1,160 @@
+/**
+Unit tests for the DQ_Jet automatic differentiation, against the derivatives of the scalar functions and against
+DQ_SerialManipulator::pose_jacobian() and the Jacobians of DQ_Kinematics.
+
+*/
+
+#include "JetTest.h"
+#include <dqrobotics/robot_modeling/DQ_GenericSerialManipulator.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (JetTest);
+
+typedef DQ_Jet<double,7> Jet;
+
+void JetTest::setUp(void)
+{
+
+}
+
+void JetTest::tearDown(void)
+{
+
+}
+
+static DQ random_pose()
+{
+    const DQ r = normalize(DQ(Vector4d::Random()));
+    const Vector3d t = Vector3d::Random();
+    return r + 0.5*E_*(t(0)*i_ + t(1)*j_ + t(2)*k_)*r;
+}
+
+/*************************************************************/
+/********   SCALAR FUNCTIONS                   ***************/
+/*************************************************************/
+
+void JetTest::scalarFunctionsTest(void)
+{
+    typedef DQ_Jet<double,2> Jet2;
+
+    for(int trial = 0; trial < 100; trial++)
+    {
+        const Vector2d values = 0.9*Vector2d::Random();
+        const Jet2 x(values(0), 0);
+        const Jet2 y(values(1), 1);
+        const double& a = values(0);
+        const double& b = values(1);
+
+        CPPUNIT_ASSERT( std::abs((x*y).v(0) - b) < 1e-15 && std::abs((x*y).v(1) - a) < 1e-15 );
+        CPPUNIT_ASSERT( std::abs(sin(x).v(0) - std::cos(a)) < 1e-15 );
+        CPPUNIT_ASSERT( std::abs(cos(x).v(0) + std::sin(a)) < 1e-15 );
+        CPPUNIT_ASSERT( std::abs(exp(x).v(0) - std::exp(a)) < 1e-15 );
+        CPPUNIT_ASSERT( std::abs(acos(x).v(0) + 1.0/std::sqrt(1.0 - a*a)) < 1e-12 );
+        CPPUNIT_ASSERT( std::abs(sqrt(x*x + 1.0).v(0) - a/std::sqrt(a*a + 1.0)) < 1e-15 );
+        CPPUNIT_ASSERT( std::abs(log(x*x + 1.0).v(0) - 2.0*a/(a*a + 1.0)) < 1e-15 );
+
+        //d atan2(y,x) = (x*dy - y*dx)/(x^2 + y^2)
+        const Jet2 angle = atan2(y,x);
+        CPPUNIT_ASSERT( std::abs(angle.a - std::atan2(b,a)) < 1e-15 );
+        CPPUNIT_ASSERT( std::abs(angle.v(0) + b/(a*a + b*b)) < 1e-12 );
+        CPPUNIT_ASSERT( std::abs(angle.v(1) - a/(a*a + b*b)) < 1e-12 );
+
+        CPPUNIT_ASSERT( std::abs((y/x).v(0) + b/(a*a)) < 1e-9*std::max(1.0, std::abs(b/(a*a))) );
+    }
+
+    //The derivative of sqrt() is taken as zero at zero
+    CPPUNIT_ASSERT( sqrt(Jet2(0.0, 0)).v.isZero() );
+}
+
+/*************************************************************/
+/********   POSE JACOBIAN                      ***************/
+/*************************************************************/
+
+/**
+* The Jacobian of the jet evaluation of fkm must be pose_jacobian(), to every link.
+*/
+static void check_pose_jacobians(const DQ_SerialManipulator& robot)
+{
+    const DQ_GenericSerialManipulator<Jet> jet_robot(robot);
+    const int n_links = robot.get_dim_configuration_space();
+
+    for(int trial = 0; trial < 20; trial++)
+    {
+        const VectorXd q = M_PI*VectorXd::Random(7);
+        const Matrix<Jet,7,1> q_jet = jet_variables<7>(q);
+
+        const GenericDQ<Jet> x = jet_robot.fkm(q_jet);
+        CPPUNIT_ASSERT( (jet_values(x.q) - vec8(robot.fkm(q))).norm() < 1e-12 );
+        CPPUNIT_ASSERT( (jet_jacobian(x.q) - robot.pose_jacobian(q)).norm() < 1e-12 );
+
+        for(int to_link = 1; to_link < n_links; to_link++)
+        {
+            //pose_jacobian(q,to_link) does not take the effector into account and has no columns for the joints after
+            //to_link, whose derivatives are zero
+            const MatrixXd J = robot.pose_jacobian(q, to_link);
+            const MatrixXd J_jet = jet_jacobian((jet_robot.reference_frame()*jet_robot.raw_fkm(q_jet, to_link)).q);
+            CPPUNIT_ASSERT( (J_jet.leftCols(J.cols()) - J).norm() < 1e-12 );
+            CPPUNIT_ASSERT( J_jet.rightCols(7 - J.cols()).isZero() );
+        }
+    }
+}
+
+void JetTest::poseJacobianTest(void)
+{
+    DQ_SerialManipulator kuka = KukaLw4Robot::kinematics();
+    kuka.set_reference_frame(random_pose());
+    kuka.set_effector(random_pose());
+    check_pose_jacobians(kuka);
+
+    //The modified convention, with a dummy joint
+    MatrixXd dh_matrix(5,8);
+    dh_matrix.topRows(4) = MatrixXd::Random(4,8);
+    dh_matrix.row(4) << 0, 0, 1, 0, 0, 0, 0, 0;
+    DQ_SerialManipulator robot(dh_matrix, "modified");
+    robot.set_reference_frame(random_pose());
+    robot.set_effector(random_pose());
+    check_pose_jacobians(robot);
+}
+
+/*************************************************************/
+/********   TASK JACOBIANS                     ***************/
+/*************************************************************/
+
+void JetTest::taskJacobianTest(void)
+{
+    DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+    robot.set_effector(random_pose());
+    const DQ_GenericSerialManipulator<Jet> jet_robot(robot);
+    const DQ_GenericSerialManipulator<double> double_robot(robot);
+    const GenericDQ<Jet> desired_pose(random_pose());
+
+    for(int trial = 0; trial < 20; trial++)
+    {
+        const VectorXd q = VectorXd::Random(7);
+        const GenericDQ<Jet> x_jet = jet_robot.fkm(jet_variables<7>(q));
+        const DQ x = robot.fkm(q);
+        const MatrixXd J = robot.pose_jacobian(q);
+
+        //Jacobians of DQ_Kinematics, which are derived by hand from the pose Jacobian, of the quaternions t and r
+        const MatrixXd J_t = jet_jacobian(translation(x_jet).q);
+        const MatrixXd J_r = jet_jacobian(rotation(x_jet).q);
+        CPPUNIT_ASSERT( (J_t.topRows(4) - DQ_Kinematics::translation_jacobian(J, x)).norm() < 1e-12 );
+        CPPUNIT_ASSERT( J_t.bottomRows(4).isZero() );
+        CPPUNIT_ASSERT( (J_r.topRows(4) - DQ_Kinematics::rotation_jacobian(J)).norm() < 1e-12 );
+        CPPUNIT_ASSERT( J_r.bottomRows(4).isZero() );
+
+        //A task without an analytical Jacobian, against central finite differences
+        const MatrixXd J_log = jet_jacobian(log(conj(desired_pose)*x_jet).q);
+        const GenericDQ<double> desired_pose_double(DQ(jet_values(desired_pose.q)));
+        const double h = 1e-6;
+        for(int k = 0; k < 7; k++)
+        {
+            VectorXd q_plus = q, q_minus = q;
+            q_plus(k) += h;
+            q_minus(k) -= h;
+            const Matrix<double,8,1> f_plus  = log(conj(desired_pose_double)*double_robot.fkm(q_plus)).q;
+            const Matrix<double,8,1> f_minus = log(conj(desired_pose_double)*double_robot.fkm(q_minus)).q;
+            CPPUNIT_ASSERT( (J_log.col(k) - (f_plus - f_minus)/(2.0*h)).norm() < 1e-7 );
+        }
+    }
+}
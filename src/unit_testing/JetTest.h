@@ -0,0 +1,36 @@
+/**
+Unit tests header file for testing the DQ_Jet automatic differentiation against the analytical Jacobians.
+
+*/
+
+
+#ifndef JETTEST_H
+#define JETTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <dqrobotics/utils/DQ_Jet.h>
+
+using namespace Eigen;
+using namespace DQ_robotics;
+
+class JetTest : public CppUnit::TestFixture
+{
+
+    CPPUNIT_TEST_SUITE (JetTest);
+    CPPUNIT_TEST (scalarFunctionsTest);
+    CPPUNIT_TEST (poseJacobianTest);
+    CPPUNIT_TEST (taskJacobianTest);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void scalarFunctionsTest();
+    void poseJacobianTest();
+    void taskJacobianTest();
+};
+
+#endif
@@ -0,0 +1,160 @@
+/**
+Unit tests for the pseudo-inverses of DQ_LinearAlgebra, against the full SVD.
+
+*/
+
+#include "LinearAlgebraTest.h"
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (LinearAlgebraTest);
+
+void LinearAlgebraTest::setUp(void)
+{
+
+}
+
+void LinearAlgebraTest::tearDown(void)
+{
+
+}
+
+/**
+* A rows x cols matrix with the given singular values and random singular vectors.
+*/
+static MatrixXd matrix_with_singular_values(const int& rows, const int& cols, const VectorXd& singular_values)
+{
+    const MatrixXd U = HouseholderQR<MatrixXd>(MatrixXd::Random(rows,rows)).householderQ();
+    const MatrixXd V = HouseholderQR<MatrixXd>(MatrixXd::Random(cols,cols)).householderQ();
+    MatrixXd S = MatrixXd::Zero(rows,cols);
+    S.diagonal().head(singular_values.size()) = singular_values;
+    return U*S*V.transpose();
+}
+
+/**
+* V*f(S)*U^T from the full SVD, with f(s) = 1/s for s > tolerance and 0 otherwise, or s/(s^2 + damping^2) when damping
+* is positive.
+*/
+static MatrixXd reference_pinv(const MatrixXd& matrix, const double& tolerance, const double& damping = 0.0)
+{
+    JacobiSVD<MatrixXd> svd(matrix, ComputeFullU | ComputeFullV);
+    const VectorXd& s = svd.singularValues();
+    MatrixXd S = MatrixXd::Zero(matrix.cols(), matrix.rows());
+    for(int i = 0; i < s.size(); i++)
+    {
+        if(damping > 0.0)
+            S(i,i) = s(i)/(s(i)*s(i) + damping*damping);
+        else if(s(i) > tolerance)
+            S(i,i) = 1.0/s(i);
+    }
+    return svd.matrixV()*S*svd.matrixU().transpose();
+}
+
+static std::vector<MatrixXd> test_matrices()
+{
+    std::vector<MatrixXd> matrices;
+    //Jacobian shapes, square, single rows and columns
+    const int shapes[][2] = {{8,7}, {7,8}, {8,3}, {3,8}, {6,6}, {1,5}, {5,1}, {8,8}};
+    for(const auto& shape : shapes)
+        matrices.push_back(MatrixXd::Random(shape[0],shape[1]));
+    //Rank deficient
+    matrices.push_back(MatrixXd::Random(8,4)*MatrixXd::Random(4,7));
+    matrices.push_back(MatrixXd::Random(6,2)*MatrixXd::Random(2,8));
+    return matrices;
+}
+
+/*************************************************************/
+/********   PSEUDO-INVERSE TESTING             ***************/
+/*************************************************************/
+
+void LinearAlgebraTest::pinvTest(void)
+{
+    for(const MatrixXd& A : test_matrices())
+    {
+        const MatrixXd P = pinv(A);
+        JacobiSVD<MatrixXd> svd(A);
+        const double tolerance = std::max(A.rows(),A.cols())*svd.singularValues()(0)*std::numeric_limits<double>::epsilon();
+
+        CPPUNIT_ASSERT( P.rows() == A.cols() && P.cols() == A.rows() );
+        CPPUNIT_ASSERT( (P - reference_pinv(A, tolerance)).norm() < 1e-10*P.norm() );
+
+        //Moore-Penrose conditions
+        CPPUNIT_ASSERT( (A*P*A - A).norm() < 1e-12*A.norm() );
+        CPPUNIT_ASSERT( (P*A*P - P).norm() < 1e-12*P.norm() );
+        CPPUNIT_ASSERT( ((A*P).transpose() - A*P).norm() < 1e-12 );
+        CPPUNIT_ASSERT( ((P*A).transpose() - P*A).norm() < 1e-12 );
+    }
+
+    CPPUNIT_ASSERT( pinv(MatrixXd::Zero(4,3)).isZero() );
+    CPPUNIT_ASSERT( pinv(MatrixXd(0,3)).size() == 0 );
+}
+
+void LinearAlgebraTest::truncatedPinvTest(void)
+{
+    VectorXd singular_values(6);
+    singular_values << 10.0, 3.0, 1.0, 1e-3, 1e-6, 1e-9;
+
+    const int shapes[][2] = {{8,7}, {7,8}, {8,6}, {6,6}, {12,10}};
+    for(const auto& shape : shapes)
+    {
+        const MatrixXd A = matrix_with_singular_values(shape[0], shape[1], singular_values);
+
+        //Tolerances served by the Gram matrix and by the SVD, between the singular values
+        const double tolerances[] = {2.0, 1e-2, 1e-4, 1e-7, 0.0};
+        for(const double& tolerance : tolerances)
+        {
+            const MatrixXd P = truncated_pinv(A, tolerance);
+            const MatrixXd P_reference = reference_pinv(A, tolerance);
+            CPPUNIT_ASSERT( (P - P_reference).norm() < 1e-8*P_reference.norm() );
+        }
+    }
+
+    CPPUNIT_ASSERT_THROW( truncated_pinv(MatrixXd::Random(3,3), -1.0), std::range_error );
+}
+
+void LinearAlgebraTest::dampedPinvTest(void)
+{
+    for(const MatrixXd& A : test_matrices())
+    {
+        const double dampings[] = {1e-3, 0.1, 1.0};
+        for(const double& damping : dampings)
+        {
+            const MatrixXd P = damped_pinv(A, damping);
+            //The Gram matrix is factorized, whose condition number is up to (largest singular value/damping)^2
+            CPPUNIT_ASSERT( (P - reference_pinv(A, 0.0, damping)).norm() < 1e-8*P.norm() );
+        }
+    }
+
+    CPPUNIT_ASSERT_THROW( damped_pinv(MatrixXd::Random(3,3), 0.0), std::range_error );
+}
+
+void LinearAlgebraTest::workspaceTest(void)
+{
+    //One workspace reused across sizes gives the same results as the allocating overloads
+    DQ_PseudoinverseWorkspace workspace(8,7);
+    for(int round = 0; round < 2; round++)
+    {
+        for(const MatrixXd& A : test_matrices())
+        {
+            MatrixXd P(A.cols(), A.rows());
+
+            pinv(A, workspace, P);
+            CPPUNIT_ASSERT( P == pinv(A) );
+
+            truncated_pinv(A, 1e-2, workspace, P);
+            CPPUNIT_ASSERT( P == truncated_pinv(A, 1e-2) );
+            truncated_pinv(A, 1e-9, workspace, P);
+            CPPUNIT_ASSERT( P == truncated_pinv(A, 1e-9) );
+
+            damped_pinv(A, 0.1, workspace, P);
+            CPPUNIT_ASSERT( P == damped_pinv(A, 0.1) );
+        }
+    }
+
+    //The result must have the size of the transpose
+    MatrixXd P(8,7);
+    CPPUNIT_ASSERT_THROW( pinv(MatrixXd::Random(8,7), workspace, P), std::range_error );
+    CPPUNIT_ASSERT_THROW( truncated_pinv(MatrixXd::Random(8,7), 1e-2, workspace, P), std::range_error );
+    CPPUNIT_ASSERT_THROW( damped_pinv(MatrixXd::Random(8,7), 0.1, workspace, P), std::range_error );
+}
@@ -0,0 +1,38 @@
+/**
+Unit tests header file for testing the pseudo-inverses of DQ_LinearAlgebra.
+
+*/
+
+
+#ifndef LINEARALGEBRATEST_H
+#define LINEARALGEBRATEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <dqrobotics/utils/DQ_LinearAlgebra.h>
+
+using namespace Eigen;
+using namespace DQ_robotics;
+
+class LinearAlgebraTest : public CppUnit::TestFixture
+{
+
+    CPPUNIT_TEST_SUITE (LinearAlgebraTest);
+    CPPUNIT_TEST (pinvTest);
+    CPPUNIT_TEST (truncatedPinvTest);
+    CPPUNIT_TEST (dampedPinvTest);
+    CPPUNIT_TEST (workspaceTest);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void pinvTest();
+    void truncatedPinvTest();
+    void dampedPinvTest();
+    void workspaceTest();
+};
+
+#endif
@@ -0,0 +1,223 @@
+/**
+Unit tests for DQ_ActiveSetQuadraticProgrammingSolver, against a brute-force solution of the KKT conditions.
+
+*/
+
+#include "QuadraticProgrammingSolverTest.h"
+#include <stdexcept>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (QuadraticProgrammingSolverTest);
+
+void QuadraticProgrammingSolverTest::setUp(void)
+{
+
+}
+
+void QuadraticProgrammingSolverTest::tearDown(void)
+{
+
+}
+
+struct QuadraticProgram
+{
+    MatrixXd H;
+    VectorXd f;
+    MatrixXd A;
+    VectorXd b;
+    MatrixXd Aeq;
+    VectorXd beq;
+};
+
+/**
+* A random strictly convex program with n variables, m inequalities, and p equalities, all satisfied by a random point.
+*/
+static QuadraticProgram random_program(const int& n, const int& m, const int& p)
+{
+    QuadraticProgram qp;
+    const MatrixXd M = MatrixXd::Random(n,n);
+    qp.H = M*M.transpose() + 0.1*MatrixXd::Identity(n,n);
+    qp.f = 2.0*VectorXd::Random(n);
+
+    const VectorXd x_feasible = VectorXd::Random(n);
+    qp.A = MatrixXd::Random(m,n);
+    qp.b = qp.A*x_feasible + 0.5*(VectorXd::Random(m) + VectorXd::Ones(m));
+    qp.Aeq = MatrixXd::Random(p,n);
+    qp.beq = qp.Aeq*x_feasible;
+    return qp;
+}
+
+/**
+* Tries every subset of the inequalities as the active set and returns the first x that satisfies the KKT conditions:
+* H*x + f + A_S^T*mu + Aeq^T*nu = 0, A_S*x = b_S, Aeq*x = beq, A*x <= b, mu >= 0. The program is strictly convex, so
+* that x is its unique solution.
+* \return false if no subset satisfies the KKT conditions, i.e. the program is infeasible.
+*/
+static bool brute_force_solution(const QuadraticProgram& qp, VectorXd& x)
+{
+    const int n = qp.H.rows();
+    const int m = qp.A.rows();
+    const int p = qp.Aeq.rows();
+    const double tolerance = 1e-9;
+
+    for(int subset = 0; subset < (1 << m); subset++)
+    {
+        std::vector<int> active;
+        for(int i = 0; i < m; i++)
+            if(subset & (1 << i))
+                active.push_back(i);
+        const int k = p + active.size();
+        if(k > n)
+            continue;
+
+        MatrixXd C(k,n);
+        VectorXd d(k);
+        C.topRows(p) = qp.Aeq;
+        d.head(p) = qp.beq;
+        for(std::size_t i = 0; i < active.size(); i++)
+        {
+            C.row(p + i) = qp.A.row(active[i]);
+            d(p + i) = qp.b(active[i]);
+        }
+
+        MatrixXd K = MatrixXd::Zero(n + k, n + k);
+        K.topLeftCorner(n,n) = qp.H;
+        K.topRightCorner(n,k) = C.transpose();
+        K.bottomLeftCorner(k,n) = C;
+        VectorXd rhs(n + k);
+        rhs << -qp.f, d;
+
+        FullPivLU<MatrixXd> lu(K);
+        if(!lu.isInvertible())
+            continue;
+        const VectorXd solution = lu.solve(rhs);
+        const VectorXd candidate = solution.head(n);
+        const VectorXd multipliers = solution.tail(k);
+
+        if(m > 0 && (qp.A*candidate - qp.b).maxCoeff() > tolerance)
+            continue;
+        if(multipliers.tail(active.size()).size() > 0 && multipliers.tail(active.size()).minCoeff() < -tolerance)
+            continue;
+        x = candidate;
+        return true;
+    }
+    return false;
+}
+
+/*************************************************************/
+/********   SOLUTION TESTING                   ***************/
+/*************************************************************/
+
+void QuadraticProgrammingSolverTest::kktTest(void)
+{
+    DQ_ActiveSetQuadraticProgrammingSolver solver;
+    solver.set_hot_start(false);
+
+    for(int trial = 0; trial < 1000; trial++)
+    {
+        const int n = 1 + trial%6;
+        const int m = (trial/6)%8;
+        const int p = (trial/48)%n;
+        const QuadraticProgram qp = random_program(n, m, p);
+
+        VectorXd x_reference;
+        CPPUNIT_ASSERT( brute_force_solution(qp, x_reference) );
+
+        CPPUNIT_ASSERT( solver.solve(qp.H, qp.f, qp.A, qp.b, qp.Aeq, qp.beq) == DQ_ActiveSetQuadraticProgrammingSolver::Status::solved );
+        const VectorXd& x = solver.solution();
+        CPPUNIT_ASSERT( (x - x_reference).norm() < 1e-8*(1.0 + x_reference.norm()) );
+        CPPUNIT_ASSERT( std::abs(solver.objective_value() - (0.5*x.dot(qp.H*x) + qp.f.dot(x))) < 1e-8*(1.0 + x.squaredNorm()) );
+
+        //The reported active inequalities hold with equality
+        const VectorXi active = solver.active_inequality_constraints();
+        for(int i = 0; i < active.size(); i++)
+            CPPUNIT_ASSERT( std::abs(qp.A.row(active(i)).dot(x) - qp.b(active(i))) < 1e-8 );
+    }
+}
+
+void QuadraticProgrammingSolverTest::hotStartTest(void)
+{
+    DQ_ActiveSetQuadraticProgrammingSolver hot_solver;
+    DQ_ActiveSetQuadraticProgrammingSolver cold_solver;
+    cold_solver.set_hot_start(false);
+
+    //A sequence of slowly changing programs, as in a control loop
+    QuadraticProgram qp = random_program(7, 14, 0);
+    const VectorXd f_dot = VectorXd::Random(7);
+    for(int step = 0; step < 200; step++)
+    {
+        qp.f += 0.05*f_dot;
+        CPPUNIT_ASSERT( hot_solver.solve(qp.H, qp.f, qp.A, qp.b, qp.Aeq, qp.beq) == DQ_ActiveSetQuadraticProgrammingSolver::Status::solved );
+        CPPUNIT_ASSERT( cold_solver.solve(qp.H, qp.f, qp.A, qp.b, qp.Aeq, qp.beq) == DQ_ActiveSetQuadraticProgrammingSolver::Status::solved );
+        CPPUNIT_ASSERT( (hot_solver.solution() - cold_solver.solution()).norm() < 1e-9*(1.0 + cold_solver.solution().norm()) );
+    }
+}
+
+void QuadraticProgrammingSolverTest::infeasibleTest(void)
+{
+    DQ_ActiveSetQuadraticProgrammingSolver solver;
+    const MatrixXd H = MatrixXd::Identity(2,2);
+    const VectorXd f = VectorXd::Zero(2);
+    const MatrixXd no_equalities(0,2);
+    const VectorXd no_equalities_b(0);
+
+    //x1 <= -1 and x1 >= 1
+    MatrixXd A(2,2);
+    A << 1, 0,
+        -1, 0;
+    VectorXd b(2);
+    b << -1, -1;
+    CPPUNIT_ASSERT( solver.solve(H, f, A, b, no_equalities, no_equalities_b) == DQ_ActiveSetQuadraticProgrammingSolver::Status::infeasible );
+    CPPUNIT_ASSERT_THROW( solver.solve_quadratic_program(H, f, A, b, no_equalities, no_equalities_b), std::runtime_error );
+
+    //x1 + x2 = 2 and x1 + x2 <= 1
+    MatrixXd Aeq(1,2);
+    Aeq << 1, 1;
+    VectorXd beq(1);
+    beq << 2;
+    MatrixXd A_sum(1,2);
+    A_sum << 1, 1;
+    VectorXd b_sum(1);
+    b_sum << 1;
+    CPPUNIT_ASSERT( solver.solve(H, f, A_sum, b_sum, Aeq, beq) == DQ_ActiveSetQuadraticProgrammingSolver::Status::infeasible );
+
+    //The solver can be used again afterwards
+    CPPUNIT_ASSERT( solver.solve(H, f, A_sum, b_sum, no_equalities, no_equalities_b) == DQ_ActiveSetQuadraticProgrammingSolver::Status::solved );
+}
+
+void QuadraticProgrammingSolverTest::equalityConstraintsTest(void)
+{
+    DQ_ActiveSetQuadraticProgrammingSolver solver;
+    const MatrixXd H = MatrixXd::Identity(2,2);
+    const VectorXd f = VectorXd::Ones(2);
+    const MatrixXd no_inequalities(0,2);
+    const VectorXd no_inequalities_b(0);
+
+    //As many equalities as variables fix the solution
+    MatrixXd Aeq(2,2);
+    Aeq << 1, 2,
+           3, 4;
+    VectorXd beq(2);
+    beq << 1, 2;
+    CPPUNIT_ASSERT( solver.solve(H, f, no_inequalities, no_inequalities_b, Aeq, beq) == DQ_ActiveSetQuadraticProgrammingSolver::Status::solved );
+    CPPUNIT_ASSERT( (Aeq*solver.solution() - beq).norm() < 1e-12 );
+
+    //Linearly dependent rows
+    MatrixXd Aeq_dependent(2,2);
+    Aeq_dependent << 1, 2,
+                     2, 4;
+    CPPUNIT_ASSERT_THROW( solver.solve(H, f, no_inequalities, no_inequalities_b, Aeq_dependent, beq), std::range_error );
+
+    //More rows than variables, which used to write past the end of the workspace
+    MatrixXd Aeq_tall(3,2);
+    Aeq_tall << 1, 0,
+                0, 1,
+                1, 1;
+    VectorXd beq_tall(3);
+    beq_tall << 1, 1, 2;
+    CPPUNIT_ASSERT_THROW( solver.solve(H, f, no_inequalities, no_inequalities_b, Aeq_tall, beq_tall), std::range_error );
+
+    //The solver can be used again afterwards
+    CPPUNIT_ASSERT( solver.solve(H, f, no_inequalities, no_inequalities_b, Aeq, beq) == DQ_ActiveSetQuadraticProgrammingSolver::Status::solved );
+    CPPUNIT_ASSERT( (Aeq*solver.solution() - beq).norm() < 1e-12 );
+}
@@ -0,0 +1,38 @@
+/**
+Unit tests header file for testing DQ_ActiveSetQuadraticProgrammingSolver.
+
+*/
+
+
+#ifndef QUADRATICPROGRAMMINGSOLVERTEST_H
+#define QUADRATICPROGRAMMINGSOLVERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <dqrobotics/solvers/DQ_ActiveSetQuadraticProgrammingSolver.h>
+
+using namespace Eigen;
+using namespace DQ_robotics;
+
+class QuadraticProgrammingSolverTest : public CppUnit::TestFixture
+{
+
+    CPPUNIT_TEST_SUITE (QuadraticProgrammingSolverTest);
+    CPPUNIT_TEST (kktTest);
+    CPPUNIT_TEST (hotStartTest);
+    CPPUNIT_TEST (infeasibleTest);
+    CPPUNIT_TEST (equalityConstraintsTest);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void kktTest();
+    void hotStartTest();
+    void infeasibleTest();
+    void equalityConstraintsTest();
+};
+
+#endif
@@ -0,0 +1,161 @@
+/**
+Unit tests for UnitDQ, against the DQ member functions, and for the unit_fkm() of the robots.
+
+*/
+
+#include "UnitDQTest.h"
+#include <dqrobotics/robot_modeling/DQ_FixedSerialManipulator.h>
+#include <dqrobotics/robot_modeling/DQ_HolonomicBase.h>
+#include <dqrobotics/robot_modeling/DQ_WholeBody.h>
+#include <dqrobotics/robots/KukaLw4Robot.h>
+#include <dqrobotics/utils/DQ_Validation.h>
+#include <stdexcept>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (UnitDQTest);
+
+void UnitDQTest::setUp(void)
+{
+
+}
+
+void UnitDQTest::tearDown(void)
+{
+
+}
+
+/**
+* A random pose, with a rotation of any angle and a translation of up to one meter along each axis.
+*/
+static DQ random_pose()
+{
+    const DQ r = normalize(DQ(Vector4d::Random()));
+    const Vector3d t = Vector3d::Random();
+    return r + 0.5*E_*(t(0)*i_ + t(1)*j_ + t(2)*k_)*r;
+}
+
+static bool is_equal(const DQ& dq1, const DQ& dq2, const double& tolerance)
+{
+    return (vec8(dq1) - vec8(dq2)).norm() < tolerance;
+}
+
+/*************************************************************/
+/********   CHECKED CONSTRUCTOR                ***************/
+/*************************************************************/
+
+void UnitDQTest::checkedTest(void)
+{
+    for(int trial = 0; trial < 100; trial++)
+    {
+        const DQ x = random_pose();
+
+        //Unit inputs are kept, up to rounding
+        CPPUNIT_ASSERT( is_equal(UnitDQ(x), x, 1e-12) );
+
+        //Anything else is normalized, i.e. scaled and projected onto the unit dual quaternions
+        const UnitDQ scaled(3.0*x);
+        CPPUNIT_ASSERT( is_unit(scaled) );
+        CPPUNIT_ASSERT( is_equal(scaled, x, 1e-12) );
+
+        const UnitDQ perturbed(x + 0.01*DQ(VectorXd::Random(8)));
+        CPPUNIT_ASSERT( is_unit(perturbed) );
+    }
+
+    CPPUNIT_ASSERT_THROW( UnitDQ(DQ(0)), std::range_error );
+    CPPUNIT_ASSERT_THROW( UnitDQ(E_*i_), std::range_error );
+}
+
+/*************************************************************/
+/********   UNCHECKED CONSTRUCTION             ***************/
+/*************************************************************/
+
+void UnitDQTest::uncheckedTest(void)
+{
+    for(int trial = 0; trial < 100; trial++)
+    {
+        const DQ x = random_pose();
+        const UnitDQ ux = UnitDQ::unchecked(x);
+
+        //The input is stored as is
+        CPPUNIT_ASSERT( vec8(ux) == vec8(x) );
+
+        //The UnitDQ overloads must agree with the checked DQ ones on unit inputs
+        CPPUNIT_ASSERT( is_equal(ux.inv(), x.inv(), 1e-12) );
+        CPPUNIT_ASSERT( vec8(ux.inv()) == vec8(ux.conj()) );
+        CPPUNIT_ASSERT( is_equal(ux*ux.inv(), DQ(1), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(translation(ux), translation(x), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(rotation(ux), rotation(x), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(log(ux), log(x), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(pow(ux,0.5), pow(x,0.5), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(unit_exp(log(ux)), exp(log(x)), 1e-12) );
+
+        const DQ p = DQ(Vector3d::Random());
+        CPPUNIT_ASSERT( is_equal(Ad(ux,p), Ad(x,p), 1e-12) );
+    }
+
+    //Products of UnitDQs are UnitDQs
+    const UnitDQ x1 = UnitDQ::unchecked(random_pose());
+    const UnitDQ x2 = UnitDQ::unchecked(random_pose());
+    const UnitDQ x12 = x1*x2;
+    CPPUNIT_ASSERT( is_unit(x12) );
+}
+
+/*************************************************************/
+/********   unit_fkm()                         ***************/
+/*************************************************************/
+
+void UnitDQTest::unitFkmTest(void)
+{
+    DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+    robot.set_reference_frame(random_pose());
+    robot.set_effector(random_pose());
+    const DQ_FixedSerialManipulator<7> fixed_robot(robot);
+
+    //The default implementation, which normalizes the result of fkm()
+    DQ_HolonomicBase base;
+    base.set_frame_displacement(random_pose());
+    DQ_WholeBody whole_body(&base);
+    whole_body.add(&robot);
+
+    for(int trial = 0; trial < 20; trial++)
+    {
+        const VectorXd q = VectorXd::Random(7);
+        const VectorXd q_base = VectorXd::Random(3);
+        VectorXd q_whole_body(10);
+        q_whole_body << q_base, q;
+
+        CPPUNIT_ASSERT( vec8(robot.unit_fkm(q)) == vec8(robot.fkm(q)) );
+        CPPUNIT_ASSERT( is_equal(fixed_robot.unit_fkm(q), robot.fkm(q), 1e-12) );
+        CPPUNIT_ASSERT( vec8(base.unit_fkm(q_base)) == vec8(base.fkm(q_base)) );
+        CPPUNIT_ASSERT( is_equal(whole_body.unit_fkm(q_whole_body), whole_body.fkm(q_whole_body), 1e-12) );
+        CPPUNIT_ASSERT( is_equal(whole_body.DQ_Kinematics::unit_fkm(q_whole_body), whole_body.fkm(q_whole_body), 1e-12) );
+        CPPUNIT_ASSERT( is_unit(robot.unit_fkm(q)) );
+    }
+}
+
+/*************************************************************/
+/********   SETTER VALIDATION                  ***************/
+/*************************************************************/
+
+void UnitDQTest::setterValidationTest(void)
+{
+    //unit_fkm() does not normalize, so the setters must reject poses that are not unit
+    if(!input_validation_enabled())
+        return;
+
+    DQ_SerialManipulator robot = KukaLw4Robot::kinematics();
+    DQ_FixedSerialManipulator<7> fixed_robot(robot);
+    DQ_HolonomicBase base;
+
+    CPPUNIT_ASSERT_THROW( robot.set_effector(2.0*DQ(1)), std::range_error );
+    CPPUNIT_ASSERT_THROW( robot.set_reference_frame(1 + E_*i_ + j_), std::range_error );
+    CPPUNIT_ASSERT_THROW( fixed_robot.set_effector(2.0*DQ(1)), std::range_error );
+    CPPUNIT_ASSERT_THROW( fixed_robot.set_reference_frame(2.0*DQ(1)), std::range_error );
+    CPPUNIT_ASSERT_THROW( base.set_frame_displacement(2.0*DQ(1)), std::range_error );
+
+    //The rejected poses are not stored
+    CPPUNIT_ASSERT( vec8(robot.effector()) == vec8(DQ(1)) );
+    CPPUNIT_ASSERT( vec8(robot.reference_frame()) == vec8(DQ(1)) );
+
+    CPPUNIT_ASSERT_NO_THROW( robot.set_effector(1 + 0.5*E_*k_) );
+    CPPUNIT_ASSERT_NO_THROW( robot.set_reference_frame(random_pose()) );
+}
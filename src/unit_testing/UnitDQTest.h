@@ -0,0 +1,38 @@
+/**
+Unit tests header file for testing UnitDQ and the unit_fkm() of the robots.
+
+*/
+
+
+#ifndef UNITDQTEST_H
+#define UNITDQTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <dqrobotics/UnitDQ.h>
+
+using namespace Eigen;
+using namespace DQ_robotics;
+
+class UnitDQTest : public CppUnit::TestFixture
+{
+
+    CPPUNIT_TEST_SUITE (UnitDQTest);
+    CPPUNIT_TEST (checkedTest);
+    CPPUNIT_TEST (uncheckedTest);
+    CPPUNIT_TEST (unitFkmTest);
+    CPPUNIT_TEST (setterValidationTest);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void checkedTest();
+    void uncheckedTest();
+    void unitFkmTest();
+    void setterValidationTest();
+};
+
+#endif
@@ -0,0 +1,113 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+/* **********************************************************************
+ *  GLOBAL ALLOCATION HOOKS
+ *  Eigen allocates with std::malloc and operator new ends up in malloc as
+ *  well, so interposing the allocators of glibc counts every heap
+ *  allocation made by the process.
+ *  This is the only interposer, it is linked into libdqrobotics when the
+ *  library is built with DQROBOTICS_INSTRUMENTATION and into
+ *  dqrobotics_bench otherwise, never into both.
+ * *********************************************************************/
+
+#include<cstddef>
+#include<cerrno>
+
+namespace
+{
+/*
+ * initial-exec addresses the counter relative to the thread pointer. The default model of a shared library goes
+ * through __tls_get_addr instead, which may allocate the first time a thread touches the variable and re-enter the
+ * hooks below.
+ */
+thread_local std::size_t allocation_count __attribute__((tls_model("initial-exec"))) = 0;
+}
+
+namespace DQ_robotics
+{
+
+/**
+ * @brief heap_allocation_count the number of heap allocations made by the current thread since it started.
+ * @return the count, always zero if the allocators could not be hooked.
+ */
+std::size_t heap_allocation_count()
+{
+    return allocation_count;
+}
+
+}
+
+#ifdef __GLIBC__
+extern "C"
+{
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+void* malloc(std::size_t size)
+{
+    allocation_count++;
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size)
+{
+    allocation_count++;
+    return __libc_calloc(count,size);
+}
+
+void* realloc(void* ptr, std::size_t size)
+{
+    allocation_count++;
+    return __libc_realloc(ptr,size);
+}
+
+void* memalign(std::size_t alignment, std::size_t size)
+{
+    allocation_count++;
+    return __libc_memalign(alignment,size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size)
+{
+    allocation_count++;
+    return __libc_memalign(alignment,size);
+}
+
+int posix_memalign(void** ptr, std::size_t alignment, std::size_t size)
+{
+    //Same preconditions as glibc: a power of two multiple of sizeof(void*)
+    if(alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0)
+        return EINVAL;
+    allocation_count++;
+    void* p = __libc_memalign(alignment,size);
+    if(p == nullptr)
+        return ENOMEM;
+    *ptr = p;
+    return 0;
+}
+}
+#else
+#warning "Allocation counting is only implemented for glibc, heap allocations will not be counted."
+#endif
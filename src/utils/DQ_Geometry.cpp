@@ -21,6 +21,7 @@ Contributors:
 */
 
 #include<dqrobotics/utils/DQ_Geometry.h>
+#include<dqrobotics/utils/DQ_Validation.h>
 
 namespace DQ_robotics
 {
@@ -36,15 +37,23 @@ namespace DQ_robotics
  */
 double DQ_Geometry::point_to_point_squared_distance(const DQ& point1, const DQ& point2)
 {
-    if(not is_pure_quaternion(point1))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(point1))
     {
         throw std::range_error("Input point1 is not a pure quaternion.");
     }
-    if(not is_pure_quaternion(point2))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(point2))
     {
         throw std::range_error("Input point2 is not a pure quaternion.");
     }
 
+    return point_to_point_squared_distance_unchecked(point1, point2);
+}
+
+/**
+ * @brief point_to_point_squared_distance_unchecked same as point_to_point_squared_distance(), without validating the inputs.
+ */
+double DQ_Geometry::point_to_point_squared_distance_unchecked(const DQ& point1, const DQ& point2)
+{
     const Vector4d a = vec4(point1-point2);
     return a.transpose()*a;
 }
@@ -61,19 +70,27 @@ double DQ_Geometry::point_to_point_squared_distance(const DQ& point1, const DQ&
  */
 double DQ_Geometry::point_to_line_squared_distance(const DQ& point, const DQ& line)
 {
-    if(not is_pure_quaternion(point))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(point))
     {
         throw std::range_error("Input point is not a pure quaternion.");
     }
-    if(not is_line(line))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(line))
     {
         throw std::range_error("Input line is not a line.");
     }
 
+    return point_to_line_squared_distance_unchecked(point, line);
+}
+
+/**
+ * @brief point_to_line_squared_distance_unchecked same as point_to_line_squared_distance(), without validating the inputs.
+ */
+double DQ_Geometry::point_to_line_squared_distance_unchecked(const DQ& point, const DQ& line)
+{
     const DQ l = P(line);
     const DQ m = D(line);
 
-    const Vector4d a = vec4(cross(point,l)-m);
+    const Vector4d a = vec4(cross_unchecked(point,l)-m);
     return a.transpose()*a;
 }
 
@@ -89,19 +106,27 @@ double DQ_Geometry::point_to_line_squared_distance(const DQ& point, const DQ& li
  */
 double DQ_Geometry::point_to_plane_distance(const DQ& point, const DQ& plane)
 {
-    if(not is_pure_quaternion(point))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_pure_quaternion(point))
     {
         throw std::range_error("Input point is not a pure quaternion.");
     }
-    if(not is_plane(plane))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_plane(plane))
     {
         throw std::range_error("Input plane is not a plane.");
     }
 
+    return point_to_plane_distance_unchecked(point, plane);
+}
+
+/**
+ * @brief point_to_plane_distance_unchecked same as point_to_plane_distance(), without validating the inputs.
+ */
+double DQ_Geometry::point_to_plane_distance_unchecked(const DQ& point, const DQ& plane)
+{
     const DQ plane_n = P(plane);
     const DQ plane_d = D(plane);
 
-    return static_cast<double>((dot(point,plane_n)-plane_d));
+    return static_cast<double>((dot_unchecked(point,plane_n)-plane_d));
 }
 
 /**
@@ -115,17 +140,25 @@ double DQ_Geometry::point_to_plane_distance(const DQ& point, const DQ& plane)
  */
 double DQ_Geometry::line_to_line_squared_distance(const DQ& line1, const DQ& line2)
 {
-    if(not is_line(line1))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(line1))
     {
         throw std::range_error("Input line1 is not a line.");
     }
-    if(not is_line(line2))
+    if(DQROBOTICS_INPUT_VALIDATION && not is_line(line2))
     {
         throw std::range_error("Input line2 is not a line.");
     }
 
-    const DQ l1_cross_l2 = cross(line1,line2);
-    const DQ l1_dot_l2   = dot(line1,line2);
+    return line_to_line_squared_distance_unchecked(line1, line2);
+}
+
+/**
+ * @brief line_to_line_squared_distance_unchecked same as line_to_line_squared_distance(), without validating the inputs.
+ */
+double DQ_Geometry::line_to_line_squared_distance_unchecked(const DQ& line1, const DQ& line2)
+{
+    const DQ l1_cross_l2 = cross_unchecked(line1,line2);
+    const DQ l1_dot_l2   = dot_unchecked(line1,line2);
 
     const double a = vec4(P(l1_cross_l2)).norm();
     const double b = vec4(D(l1_dot_l2)).norm();
@@ -0,0 +1,245 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/utils/DQ_Instrumentation.h>
+
+#include<cstring>
+#include<exception>
+#include<stdexcept>
+
+namespace
+{
+thread_local std::size_t dq_construction_count = 0;
+thread_local std::size_t dq_product_count = 0;
+
+/*
+ * Fixed-capacity per-thread table of instrumented functions. Recording a call must not allocate, otherwise an
+ * enclosing DQ_NoAllocationScope would see the bookkeeping of the instrumentation itself.
+ */
+const int MAX_INSTRUMENTED_FUNCTIONS = 64;
+
+struct CallRecord
+{
+    const char* function_name;
+    std::size_t calls;
+    std::size_t allocations;
+    std::size_t dq_constructions;
+    std::size_t dq_products;
+};
+
+thread_local CallRecord call_records[MAX_INSTRUMENTED_FUNCTIONS];
+thread_local int n_call_records = 0;
+}
+
+#ifdef DQROBOTICS_INSTRUMENTATION
+namespace DQ_robotics
+{
+//Defined next to the allocation hooks, see src/utils/DQ_AllocationHooks.cpp
+std::size_t heap_allocation_count();
+}
+#endif
+
+namespace
+{
+std::size_t allocation_count()
+{
+#ifdef DQROBOTICS_INSTRUMENTATION
+    return DQ_robotics::heap_allocation_count();
+#else
+    return 0;
+#endif
+}
+}
+
+namespace DQ_robotics
+{
+//Innermost DQ_InstrumentedCall alive on this thread
+thread_local const DQ_InstrumentedCall* active_instrumented_call = nullptr;
+}
+
+namespace DQ_robotics
+{
+
+DQ_InstrumentationCounters::DQ_InstrumentationCounters():
+    allocations(0),
+    dq_constructions(0),
+    dq_products(0)
+{
+
+}
+
+DQ_InstrumentationCounters operator+(const DQ_InstrumentationCounters& a, const DQ_InstrumentationCounters& b)
+{
+    DQ_InstrumentationCounters c;
+    c.allocations      = a.allocations      + b.allocations;
+    c.dq_constructions = a.dq_constructions + b.dq_constructions;
+    c.dq_products      = a.dq_products      + b.dq_products;
+    return c;
+}
+
+DQ_InstrumentationCounters operator-(const DQ_InstrumentationCounters& a, const DQ_InstrumentationCounters& b)
+{
+    DQ_InstrumentationCounters c;
+    c.allocations      = a.allocations      - b.allocations;
+    c.dq_constructions = a.dq_constructions - b.dq_constructions;
+    c.dq_products      = a.dq_products      - b.dq_products;
+    return c;
+}
+
+/**
+ * @brief instrumentation_enabled whether this build of the library counts allocations and DQ operations.
+ * @return true iff the library was built with DQROBOTICS_INSTRUMENTATION.
+ */
+bool instrumentation_enabled()
+{
+#ifdef DQROBOTICS_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief instrumentation_counters the running totals of the current thread.
+ * @return the counters, all zero if the instrumentation is disabled.
+ */
+DQ_InstrumentationCounters instrumentation_counters()
+{
+    DQ_InstrumentationCounters c;
+    c.allocations      = allocation_count();
+    c.dq_constructions = dq_construction_count;
+    c.dq_products      = dq_product_count;
+    return c;
+}
+
+/**
+ * @brief instrumentation_records the calls of the instrumented functions made by the current thread since it
+ * started or since the last reset_instrumentation_records(), in order of first call.
+ * @return one record per instrumented function that was called.
+ */
+std::vector<DQ_InstrumentationRecord> instrumentation_records()
+{
+    std::vector<DQ_InstrumentationRecord> records(n_call_records);
+    for(int i=0;i<n_call_records;i++)
+    {
+        records[i].function_name           = call_records[i].function_name;
+        records[i].calls                   = call_records[i].calls;
+        records[i].totals.allocations      = call_records[i].allocations;
+        records[i].totals.dq_constructions = call_records[i].dq_constructions;
+        records[i].totals.dq_products      = call_records[i].dq_products;
+    }
+    return records;
+}
+
+void reset_instrumentation_records()
+{
+    n_call_records = 0;
+}
+
+void instrumentation_count_dq_construction()
+{
+    dq_construction_count++;
+}
+
+void instrumentation_count_dq_product()
+{
+    dq_product_count++;
+}
+
+DQ_InstrumentationScope::DQ_InstrumentationScope():
+    start_(instrumentation_counters())
+{
+
+}
+
+DQ_InstrumentationCounters DQ_InstrumentationScope::counters() const
+{
+    return instrumentation_counters() - start_;
+}
+
+DQ_NoAllocationScope::DQ_NoAllocationScope(const char* description):
+    start_allocations_(allocation_count()),
+    description_(description)
+{
+
+}
+
+DQ_NoAllocationScope::~DQ_NoAllocationScope() noexcept(false)
+{
+    const std::size_t n_allocations = allocations();
+    if(n_allocations > 0 && !std::uncaught_exception())
+    {
+        throw std::range_error(std::string(description_) + ": " + std::to_string(n_allocations) + " heap allocation(s) inside a no-allocation scope.");
+    }
+}
+
+std::size_t DQ_NoAllocationScope::allocations() const
+{
+    return allocation_count() - start_allocations_;
+}
+
+DQ_InstrumentedCall::DQ_InstrumentedCall(const char* function_name):
+    function_name_(function_name),
+    parent_(active_instrumented_call),
+    nested_(false),
+    start_(instrumentation_counters())
+{
+    for(const DQ_InstrumentedCall* call = parent_; call != nullptr; call = call->parent_)
+    {
+        if(std::strcmp(call->function_name_,function_name_) == 0)
+        {
+            nested_ = true;
+            break;
+        }
+    }
+    active_instrumented_call = this;
+}
+
+DQ_InstrumentedCall::~DQ_InstrumentedCall()
+{
+    active_instrumented_call = parent_;
+    if(nested_)
+        return;
+
+    const DQ_InstrumentationCounters delta = instrumentation_counters() - start_;
+
+    int i = 0;
+    while(i < n_call_records && std::strcmp(call_records[i].function_name,function_name_) != 0)
+        i++;
+    if(i == n_call_records)
+    {
+        if(n_call_records == MAX_INSTRUMENTED_FUNCTIONS)
+            return;
+        call_records[i].function_name    = function_name_;
+        call_records[i].calls            = 0;
+        call_records[i].allocations      = 0;
+        call_records[i].dq_constructions = 0;
+        call_records[i].dq_products      = 0;
+        n_call_records++;
+    }
+    call_records[i].calls++;
+    call_records[i].allocations      += delta.allocations;
+    call_records[i].dq_constructions += delta.dq_constructions;
+    call_records[i].dq_products      += delta.dq_products;
+}
+
+}
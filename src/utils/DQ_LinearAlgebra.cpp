@@ -21,10 +21,134 @@ Contributors:
 */
 
 #include<dqrobotics/utils/DQ_LinearAlgebra.h>
+#include<algorithm>
+#include<cmath>
+#include<limits>
+#include<stdexcept>
+#include<string>
 
 namespace DQ_robotics
 {
 
+namespace
+{
+
+void check_pseudo_inverse_size_(const MatrixXd& matrix, const Ref<MatrixXd>& pseudo_inverse, const char* function_name)
+{
+    if(pseudo_inverse.rows() != matrix.cols() || pseudo_inverse.cols() != matrix.rows())
+    {
+        throw std::range_error(std::string("Bad ") + function_name + " call: pseudo_inverse must have the size of the transpose of matrix");
+    }
+}
+
+/**
+ * pseudo_inverse = V*inv(S)*U^T from the thin SVD of matrix, where singular values not larger than tolerance are
+ * taken as zero. The thin SVD only computes the min(rows,cols) columns of U and V that contribute.
+ */
+void svd_pinv_(const MatrixXd& matrix, const double* tolerance, DQ_PseudoinverseWorkspace& workspace, Ref<MatrixXd> pseudo_inverse)
+{
+    const int num_rows = matrix.rows();
+    const int num_cols = matrix.cols();
+    if(num_rows == 0 || num_cols == 0)
+    {
+        pseudo_inverse.setZero();
+        return;
+    }
+
+    if(workspace.svd.rows() != num_rows || workspace.svd.cols() != num_cols || !workspace.svd.computeU())
+        workspace.svd = JacobiSVD<MatrixXd>(num_rows, num_cols, ComputeThinU | ComputeThinV);
+    workspace.svd.compute(matrix);
+    const auto& singular_values = workspace.svd.singularValues();
+    const int rank_bound = singular_values.size();
+
+    double tol;
+    if(tolerance)
+    {
+        tol = *tolerance;
+    }
+    else
+    {
+        //Matlab uses the 2-NORM, which is the largest singular value. Meyer p.281
+        tol = std::max(num_rows,num_cols)*singular_values(0)*std::numeric_limits<double>::epsilon();
+    }
+
+    workspace.scaled_v.resize(num_cols, rank_bound);
+    for(int i=0;i<rank_bound;i++)
+    {
+        if(singular_values(i) > tol)
+            workspace.scaled_v.col(i) = workspace.svd.matrixV().col(i)/singular_values(i);
+        else
+            workspace.scaled_v.col(i).setZero();
+    }
+    pseudo_inverse.noalias() = workspace.scaled_v*workspace.svd.matrixU().transpose();
+}
+
+/**
+ * Truncated pseudo-inverse from the eigendecomposition of the smaller Gram matrix, G = matrix*matrix^T or
+ * matrix^T*matrix, whose eigenvalues are the squared singular values. It is several times faster than the SVD for
+ * Jacobian-sized matrices, but forming G squares the condition number: its eigenvalues are only accurate to about
+ * size(G)*eps*max_eigenvalue. It is used when G fits the fixed capacity of the workspace and tolerance^2 is well
+ * above that accuracy, otherwise it returns false and nothing is written.
+ */
+bool gram_truncated_pinv_(const MatrixXd& matrix, const double& tolerance, DQ_PseudoinverseWorkspace& workspace, Ref<MatrixXd> pseudo_inverse)
+{
+    //Relative accuracy of the retained eigenvalues of about 1e-6
+    const double ACCURACY_MARGIN = 1e6;
+
+    const bool wide = matrix.rows() <= matrix.cols();
+    const int gram_size = wide ? matrix.rows() : matrix.cols();
+    if(gram_size > DQ_PseudoinverseWorkspace::GramMatrix::MaxRowsAtCompileTime)
+        return false;
+
+    DQ_PseudoinverseWorkspace::GramMatrix& gram = workspace.small_gram;
+    gram.resize(gram_size, gram_size);
+    if(wide)
+        gram.noalias() = matrix*matrix.transpose();
+    else
+        gram.noalias() = matrix.transpose()*matrix;
+
+    workspace.eigen_solver.compute(gram);
+    const auto& eigenvalues  = workspace.eigen_solver.eigenvalues();
+    const auto& eigenvectors = workspace.eigen_solver.eigenvectors();
+
+    //Eigenvalues are sorted in increasing order
+    const double squared_tolerance = tolerance*tolerance;
+    if(squared_tolerance < ACCURACY_MARGIN*gram_size*std::numeric_limits<double>::epsilon()*eigenvalues(gram_size-1))
+        return false;
+
+    //pinv(G) = V*inv(D)*V^T, keeping the eigenvalues above tolerance^2
+    workspace.scaled_eigenvectors.resize(gram_size, gram_size);
+    for(int i=0;i<gram_size;i++)
+    {
+        if(eigenvalues(i) > squared_tolerance)
+            workspace.scaled_eigenvectors.col(i) = eigenvectors.col(i)/eigenvalues(i);
+        else
+            workspace.scaled_eigenvectors.col(i).setZero();
+    }
+    gram.noalias() = workspace.scaled_eigenvectors*eigenvectors.transpose();
+
+    //pinv(matrix) = matrix^T*pinv(matrix*matrix^T) = pinv(matrix^T*matrix)*matrix^T
+    if(wide)
+        pseudo_inverse.noalias() = matrix.transpose()*gram;
+    else
+        pseudo_inverse.noalias() = gram*matrix.transpose();
+    return true;
+}
+
+}
+
+/**
+ * @brief Creates a workspace for matrices with @p rows rows and @p cols columns.
+ */
+DQ_PseudoinverseWorkspace::DQ_PseudoinverseWorkspace(const int& rows, const int& cols):
+    svd(rows, cols, ComputeThinU | ComputeThinV),
+    ldlt(std::min(rows,cols)),
+    gram(std::min(rows,cols), std::min(rows,cols)),
+    scaled_v(cols, std::min(rows,cols))
+{
+
+}
+
 /**
  * @brief pinv Calculates the pseudo inverse of the input @p matrix using Singular Value Decomposition with
  * a given tolerance for small singular values.
@@ -34,35 +158,102 @@ namespace DQ_robotics
  */
 MatrixXd pinv(const MatrixXd& matrix)
 {
-    int num_rows = matrix.rows();
-    int num_cols = matrix.cols();
+    DQ_PseudoinverseWorkspace workspace;
+    MatrixXd pseudo_inverse(matrix.cols(), matrix.rows());
+    pinv(matrix, workspace, pseudo_inverse);
+    return pseudo_inverse;
+}
 
-    MatrixXd pseudo_inverse(num_cols,num_rows);
-    JacobiSVD<MatrixXd> svd(num_cols,num_rows);
-    VectorXd singular_values;
-    MatrixXd svd_sigma_inverted(num_cols,num_rows);
-    svd_sigma_inverted = MatrixXd::Zero(num_cols,num_rows);
+/**
+ * @brief truncated_pinv Calculates the pseudo inverse of the input @p matrix taking the singular values not larger than
+ * @p tolerance as zero. When @p tolerance is large enough, e.g. above about 1e-4 times the largest singular value, it
+ * is calculated from the eigendecomposition of the smaller of matrix*matrix^T and matrix^T*matrix instead of the SVD,
+ * which is faster for Jacobian-sized matrices.
+ * @param matrix the input matrix
+ * @param tolerance the largest singular value that is taken as zero.
+ * @return the truncated pseudo-inverse of @p matrix.
+ */
+MatrixXd truncated_pinv(const MatrixXd& matrix, const double& tolerance)
+{
+    DQ_PseudoinverseWorkspace workspace;
+    MatrixXd pseudo_inverse(matrix.cols(), matrix.rows());
+    truncated_pinv(matrix, tolerance, workspace, pseudo_inverse);
+    return pseudo_inverse;
+}
 
-    svd.compute(matrix, ComputeFullU | ComputeFullV);
-    singular_values = svd.singularValues();
+/**
+ * @brief damped_pinv Calculates the damped least-squares pseudo inverse of the input @p matrix, that is,
+ * matrix^T*(matrix*matrix^T + damping^2*I)^-1, which equals (matrix^T*matrix + damping^2*I)^-1*matrix^T.
+ * The smaller of the two Gram matrices is factorized with LDLT, so no SVD is needed.
+ * @param matrix the input matrix
+ * @param damping the damping factor, it must be positive.
+ * @return the damped pseudo-inverse of @p matrix.
+ */
+MatrixXd damped_pinv(const MatrixXd& matrix, const double& damping)
+{
+    DQ_PseudoinverseWorkspace workspace;
+    MatrixXd pseudo_inverse(matrix.cols(), matrix.rows());
+    damped_pinv(matrix, damping, workspace, pseudo_inverse);
+    return pseudo_inverse;
+}
 
-    //Tolerance Calculation
-    double eps =  std::numeric_limits<double>::epsilon();
-    int max =  (num_rows > num_cols) ? num_rows : num_cols;
-    double norm = singular_values(0); //Matlab uses the 2-NORM, which is the largest singular value. Meyer p.281
-    double tol = max*norm*eps;
+/**
+ * @brief Same as pinv(matrix), but writes the result into @p pseudo_inverse, which must have the size of the transpose
+ * of @p matrix, and does not allocate when @p workspace was sized for @p matrix.
+ */
+void pinv(const MatrixXd& matrix, DQ_PseudoinverseWorkspace& workspace, Ref<MatrixXd> pseudo_inverse)
+{
+    check_pseudo_inverse_size_(matrix, pseudo_inverse, "pinv(matrix,workspace,pseudo_inverse)");
+    svd_pinv_(matrix, nullptr, workspace, pseudo_inverse);
+}
 
-    for(int i=0;i<singular_values.size();i++)
+/**
+ * @brief Same as truncated_pinv(matrix,tolerance), but writes the result into @p pseudo_inverse, which must have the
+ * size of the transpose of @p matrix, and does not allocate when @p workspace was sized for @p matrix.
+ */
+void truncated_pinv(const MatrixXd& matrix, const double& tolerance, DQ_PseudoinverseWorkspace& workspace, Ref<MatrixXd> pseudo_inverse)
+{
+    check_pseudo_inverse_size_(matrix, pseudo_inverse, "truncated_pinv(matrix,tolerance,workspace,pseudo_inverse)");
+    if(tolerance < 0.0)
     {
-        if(singular_values(i) > tol)
-            svd_sigma_inverted(i,i) = 1/(singular_values(i));
-        else
-            svd_sigma_inverted(i,i) = 0;
+        throw std::range_error("Bad truncated_pinv(matrix,tolerance,workspace,pseudo_inverse) call: tolerance must not be negative");
     }
+    if(matrix.size() > 0 && gram_truncated_pinv_(matrix, tolerance, workspace, pseudo_inverse))
+        return;
+    svd_pinv_(matrix, &tolerance, workspace, pseudo_inverse);
+}
 
-    pseudo_inverse = svd.matrixV() * (svd_sigma_inverted * svd.matrixU().adjoint());
+/**
+ * @brief Same as damped_pinv(matrix,damping), but writes the result into @p pseudo_inverse, which must have the size of
+ * the transpose of @p matrix, and does not allocate when @p workspace was sized for @p matrix.
+ */
+void damped_pinv(const MatrixXd& matrix, const double& damping, DQ_PseudoinverseWorkspace& workspace, Ref<MatrixXd> pseudo_inverse)
+{
+    check_pseudo_inverse_size_(matrix, pseudo_inverse, "damped_pinv(matrix,damping,workspace,pseudo_inverse)");
+    if(damping <= 0.0)
+    {
+        throw std::range_error("Bad damped_pinv(matrix,damping,workspace,pseudo_inverse) call: damping must be positive");
+    }
 
-    return pseudo_inverse;
+    const double damping_squared = damping*damping;
+    if(matrix.rows() <= matrix.cols())
+    {
+        //pseudo_inverse^T = (matrix*matrix^T + damping^2*I)^-1*matrix
+        workspace.gram.resize(matrix.rows(), matrix.rows());
+        workspace.gram.noalias() = matrix*matrix.transpose();
+        workspace.gram.diagonal().array() += damping_squared;
+        workspace.ldlt.compute(workspace.gram);
+        pseudo_inverse.transpose() = workspace.ldlt.solve(matrix);
+    }
+    else
+    {
+        //pseudo_inverse = (matrix^T*matrix + damping^2*I)^-1*matrix^T
+        workspace.gram.resize(matrix.cols(), matrix.cols());
+        workspace.gram.noalias() = matrix.transpose()*matrix;
+        workspace.gram.diagonal().array() += damping_squared;
+        workspace.ldlt.compute(workspace.gram);
+        pseudo_inverse = workspace.ldlt.solve(matrix.transpose());
+    }
 }
 
 }
@@ -0,0 +1,273 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/utils/DQ_Parallel.h>
+
+#include<algorithm>
+#include<atomic>
+#include<condition_variable>
+#include<deque>
+#include<exception>
+#include<functional>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+namespace DQ_robotics
+{
+
+namespace
+{
+
+/**
+ * The tasks [begin,end) still owned by one worker. The owner takes tasks from the front,
+ * thieves take the back half.
+ */
+struct TaskRange
+{
+    std::mutex mutex;
+    int begin = 0;
+    int end   = 0;
+};
+
+bool pop_front(TaskRange& range, int& task)
+{
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if(range.begin >= range.end)
+        return false;
+    task = range.begin++;
+    return true;
+}
+
+bool steal_back_half(TaskRange& victim, int& begin, int& end)
+{
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    const int remaining = victim.end - victim.begin;
+    if(remaining <= 0)
+        return false;
+    end         = victim.end;
+    begin       = victim.end - (remaining+1)/2;
+    victim.end  = begin;
+    return true;
+}
+
+/**
+ * Persistent worker threads that run the jobs submitted by parallel_for(). Threads are created on demand, up to the
+ * largest number of workers requested so far, and are reused by every later call, so a call only pays for waking
+ * them up. They are joined when the program exits.
+ */
+class WorkerPool
+{
+private:
+    std::mutex                        mutex_;
+    std::condition_variable           job_available_;
+    std::deque<std::function<void()>> jobs_;
+    std::vector<std::thread>          threads_;
+    bool                              stop_ = false;
+
+    void run_()
+    {
+        while(true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                job_available_.wait(lock, [this]{ return stop_ || !jobs_.empty(); });
+                if(stop_ && jobs_.empty())
+                    return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+
+public:
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        job_available_.notify_all();
+        for(std::thread& thread : threads_)
+            thread.join();
+    }
+
+    /**
+     * Queues @p job, making sure that at least @p n_threads threads serve the queue.
+     */
+    void submit(std::function<void()> job, const int& n_threads)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while(int(threads_.size()) < n_threads)
+                threads_.emplace_back(&WorkerPool::run_, this);
+            jobs_.push_back(std::move(job));
+        }
+        job_available_.notify_one();
+    }
+};
+
+WorkerPool& worker_pool()
+{
+    //Constructed on first use, so it is safe to call parallel_for() from static initializers
+    static WorkerPool pool;
+    return pool;
+}
+
+/**
+ * Tracks the pool jobs of one parallel_for() call. Once the call is closed, jobs that have not started yet do
+ * nothing, so the call only waits for the jobs that are running.
+ */
+struct CallState
+{
+    std::mutex              mutex;
+    std::condition_variable finished;
+    int                     running = 0;
+    bool                    closed  = false;
+};
+
+}
+
+/**
+ * @brief parallel_number_of_workers the number of workers that parallel_for() uses.
+ * @param number_of_tasks the number of tasks.
+ * @param number_of_threads the requested number of threads, 0 or less means one per hardware thread.
+ * @return the number of workers, between 1 and @p number_of_tasks. Use it to size per-worker scratch memory.
+ */
+int parallel_number_of_workers(const int& number_of_tasks, const int& number_of_threads)
+{
+    int workers = number_of_threads;
+    if(workers <= 0)
+        workers = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1,std::min(workers,number_of_tasks));
+}
+
+/**
+ * @brief parallel_for runs @p task_function for every task in [0,number_of_tasks) using a work-stealing scheduler.
+ * Each worker starts with a contiguous range of tasks and, when it runs out, steals the back half of the range of
+ * another worker. The calling thread is worker 0, the other workers run on persistent threads that are created by
+* the first call that needs them and reused by later calls, so the cost of starting threads is only paid once.
+ * @param number_of_tasks the number of tasks.
+ * @param number_of_threads the number of threads, 0 or less means one per hardware thread.
+ * @see parallel_number_of_workers().
+ * @param task_function called as task_function(task,worker). Calls with the same worker index never overlap,
+ * so worker indexes can be used to address per-worker scratch memory.
+ * @exception If @p task_function throws, the remaining tasks are abandoned and the first exception is rethrown
+ * once all workers have stopped.
+ */
+void parallel_for(const int& number_of_tasks,
+                  const int& number_of_threads,
+                  const std::function<void(const int& task, const int& worker)>& task_function)
+{
+    if(number_of_tasks <= 0)
+        return;
+
+    const int n_workers = parallel_number_of_workers(number_of_tasks, number_of_threads);
+    if(n_workers == 1)
+    {
+        for(int task = 0; task < number_of_tasks; task++)
+            task_function(task,0);
+        return;
+    }
+
+    std::vector<TaskRange> ranges(n_workers);
+    for(int worker = 0; worker < n_workers; worker++)
+    {
+        ranges[worker].begin = (number_of_tasks*worker)/n_workers;
+        ranges[worker].end   = (number_of_tasks*(worker+1))/n_workers;
+    }
+
+    std::atomic<bool>  abort(false);
+    std::exception_ptr first_exception;
+    std::mutex         exception_mutex;
+
+    auto work = [&](const int worker)
+    {
+        try
+        {
+            while(!abort)
+            {
+                int task;
+                while(!abort && pop_front(ranges[worker],task))
+                    task_function(task,worker);
+
+                bool stolen = false;
+                for(int i = 1; i < n_workers && !stolen && !abort; i++)
+                {
+                    int begin, end;
+                    if(steal_back_half(ranges[(worker+i)%n_workers],begin,end))
+                    {
+                        std::lock_guard<std::mutex> lock(ranges[worker].mutex);
+                        ranges[worker].begin = begin;
+                        ranges[worker].end   = end;
+                        stolen = true;
+                    }
+                }
+                if(!stolen)
+                    return;
+            }
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(exception_mutex);
+            if(!first_exception)
+                first_exception = std::current_exception();
+            abort = true;
+        }
+    };
+
+    //Workers that the pool has not started by the time worker 0 runs out of tasks are skipped, worker 0 steals their
+    //tasks instead. This keeps nested and concurrent calls from waiting on each other.
+    const std::shared_ptr<CallState> state = std::make_shared<CallState>();
+    for(int worker = 1; worker < n_workers; worker++)
+    {
+        worker_pool().submit([state,&work,worker]()
+        {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if(state->closed)
+                    return;
+                state->running++;
+            }
+            work(worker);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->running--;
+            }
+            state->finished.notify_all();
+        }, n_workers-1);
+    }
+    work(0);
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->closed = true;
+        state->finished.wait(lock, [&state]{ return state->running == 0; });
+    }
+
+    if(first_exception)
+        std::rethrow_exception(first_exception);
+}
+
+}
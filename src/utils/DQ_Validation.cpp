@@ -0,0 +1,37 @@
+/**
+(C) Copyright 2019 DQ Robotics Developers
+
+This file is part of DQ Robotics.
+
+    DQ Robotics is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DQ Robotics is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DQ Robotics.  If not, see <http://www.gnu.org/licenses/>.
+
+Contributors:
+- Murilo M. Marinho (murilo@nml.t.u-tokyo.ac.jp)
+*/
+
+#include<dqrobotics/utils/DQ_Validation.h>
+
+namespace DQ_robotics
+{
+
+/**
+ * @brief input_validation_enabled whether this build of the library validates the inputs of its operations.
+ * @return false iff the library was built with DQROBOTICS_DISABLE_INPUT_VALIDATION and NDEBUG.
+ */
+bool input_validation_enabled()
+{
+    return DQROBOTICS_INPUT_VALIDATION;
+}
+
+}